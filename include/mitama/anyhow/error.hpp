@@ -7,10 +7,92 @@
 #include <string>
 #include <sstream>
 #include <memory>
+#include <memory_resource>
+#include <utility>
 #include <functional>
+#include <vector>
+
+namespace mitama::_anyhow_detail {
+  /// memory resource of the errors created on this thread; null for the global heap
+  inline thread_local std::pmr::memory_resource* current_resource = nullptr;
+
+  /// @brief
+  ///   Allocates from the memory resource current at its construction, or with `std::allocator` if there was none.
+  template <class T>
+  class error_allocator {
+    template <class> friend class error_allocator;
+    std::pmr::memory_resource* resource_;
+  public:
+    using value_type = T;
+
+    error_allocator() noexcept: resource_(current_resource) {}
+    explicit error_allocator(std::pmr::memory_resource* resource) noexcept: resource_(resource) {}
+    template <class U>
+    error_allocator(error_allocator<U> const& other) noexcept: resource_(other.resource_) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+      if (resource_ == nullptr) return std::allocator<T>{}.allocate(n);
+      return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+      if (resource_ == nullptr) std::allocator<T>{}.deallocate(p, n);
+      else resource_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    template <class U>
+    friend bool operator==(error_allocator const& lhs, error_allocator<U> const& rhs) noexcept {
+      return lhs.resource_ == rhs.resource_
+          || (lhs.resource_ != nullptr && rhs.resource_ != nullptr && lhs.resource_->is_equal(*rhs.resource_));
+    }
+    template <class U>
+    friend bool operator!=(error_allocator const& lhs, error_allocator<U> const& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+  };
+
+  /// `std::make_shared` if `resource` is null, `std::allocate_shared` from `resource` otherwise
+  template <class T, class... Args>
+  std::shared_ptr<T> allocate_error(std::pmr::memory_resource* resource, Args&&... args) {
+    if (resource == nullptr)
+      return std::make_shared<T>(std::forward<Args>(args)...);
+    return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>{resource}, std::forward<Args>(args)...);
+  }
+
+  /// allocates from the current memory resource
+  template <class T, class... Args>
+  std::shared_ptr<T> make_error(Args&&... args) {
+    return allocate_error<T>(current_resource, std::forward<Args>(args)...);
+  }
+
+  /// true if `Args` starts with `std::allocator_arg_t`
+  template <class... Args>
+  inline constexpr bool leading_allocator_arg_v = false;
+
+  template <class First, class... Rest>
+  inline constexpr bool leading_allocator_arg_v<First, Rest...> = std::is_same_v<std::decay_t<First>, std::allocator_arg_t>;
+}
 
 namespace mitama::anyhow {
 
+  /// @brief
+  ///   Allocates the errors created on this thread (`anyhow`, `failure<Err>`, `context`, ...)
+  ///   from `resource` until the end of the scope, instead of the global heap.
+  ///
+  /// @note
+  ///   The errors hold on to the resource: it must outlive them,
+  ///   including the errors returned out of the scope (a `mitama::arena` aborts if it does not).
+  ///   Scopes nest; the previous resource is restored on destruction.
+  class resource_scope {
+    std::pmr::memory_resource* previous_;
+  public:
+    explicit resource_scope(std::pmr::memory_resource& resource) noexcept
+      : previous_(std::exchange(_anyhow_detail::current_resource, &resource)) {}
+    resource_scope(resource_scope const&) = delete;
+    resource_scope& operator=(resource_scope const&) = delete;
+    ~resource_scope() { _anyhow_detail::current_resource = previous_; }
+  };
+
   struct error {
     virtual ~error() = default;
     virtual std::string what() const = 0;
@@ -18,7 +100,7 @@ namespace mitama::anyhow {
   };
 
   class errors final : public error, public std::enable_shared_from_this<errors> {
-    std::vector<std::shared_ptr<error>> errs_;
+    std::vector<std::shared_ptr<error>, _anyhow_detail::error_allocator<std::shared_ptr<error>>> errs_;
   public:
     errors() = default;
     errors(const errors &) = default;
@@ -27,17 +109,24 @@ namespace mitama::anyhow {
     errors &operator=(errors &&) = default;
 
     ~errors() override = default;
-    template <class ...Errors>
+    template <class ...Errors,
+      std::enable_if_t<!_anyhow_detail::leading_allocator_arg_v<Errors...>, bool> = false>
     errors(Errors&&... errs)
       : errs_{ std::forward<Errors>(errs)... } {}
 
+    /// @brief
+    ///   Allocates the chain from the memory resource of `alloc`; `context` keeps appending to it.
+    template <class U, class ...Errors>
+    errors(std::allocator_arg_t, std::pmr::polymorphic_allocator<U> const& alloc, Errors&&... errs)
+      : errs_({ std::forward<Errors>(errs)... }, decltype(errs_)::allocator_type{ alloc.resource() }) {}
+
     std::shared_ptr<error> context(std::shared_ptr<error> ctx) override {
       errs_.emplace_back(std::move(ctx));
       return std::enable_shared_from_this<errors>::shared_from_this();
     }
 
     auto chain() const {
-      return std::vector{ errs_.crbegin(), errs_.crend() };
+      return std::vector<std::shared_ptr<error>>(errs_.crbegin(), errs_.crend());
     }
 
     auto root_cause() const -> std::shared_ptr<mitama::anyhow::error> {
@@ -68,7 +157,7 @@ namespace mitama::anyhow {
     explicit cause(E err) noexcept : err(err) {}
 
     std::shared_ptr<error> context(std::shared_ptr<error> ctx) override {
-      return std::make_shared<errors>(std::enable_shared_from_this<cause<E>>::shared_from_this(), std::move(ctx));
+      return _anyhow_detail::make_error<errors>(std::enable_shared_from_this<cause<E>>::shared_from_this(), std::move(ctx));
     }
 
     std::string what() const override {
@@ -82,17 +171,35 @@ namespace mitama::anyhow {
 
   template<class E>
   auto anyhow(E &&err) -> std::shared_ptr<mitama::anyhow::error> {
-    return std::make_shared<mitama::anyhow::cause<std::decay_t<E>>>(std::forward<E>(err));
+    return _anyhow_detail::make_error<mitama::anyhow::cause<std::decay_t<E>>>(std::forward<E>(err));
   }
 
   std::ostream& operator<<(std::ostream& os, std::shared_ptr<::mitama::anyhow::error> const & err) {
     return os << err->what();
   }
 
+  /// @brief
+  ///   `anyhow(err)` allocated from the memory resource of `alloc`.
+  template<class U, class E>
+  auto anyhow(std::allocator_arg_t, std::pmr::polymorphic_allocator<U> const& alloc, E &&err)
+    -> std::shared_ptr<mitama::anyhow::error>
+  {
+    return _anyhow_detail::allocate_error<mitama::anyhow::cause<std::decay_t<E>>>(alloc.resource(), std::forward<E>(err));
+  }
+
   template <class Err, class ...Args>
   auto failure(Args&&... args)
+    -> std::enable_if_t<
+        std::is_base_of_v<mitama::anyhow::error, Err> && !_anyhow_detail::leading_allocator_arg_v<Args...>,
+        mitama::failure_t<std::shared_ptr<Err>>>
+    { return mitama::failure(_anyhow_detail::make_error<Err>(std::forward<Args>(args)...)); }
+
+  /// @brief
+  ///   `failure<Err>(args...)` allocated from the memory resource of `alloc`.
+  template <class Err, class U, class ...Args>
+  auto failure(std::allocator_arg_t, std::pmr::polymorphic_allocator<U> const& alloc, Args&&... args)
     -> std::enable_if_t<std::is_base_of_v<mitama::anyhow::error, Err>, mitama::failure_t<std::shared_ptr<Err>>>
-    { return mitama::failure(std::make_shared<Err>(std::forward<Args>(args)...)); }
+    { return mitama::failure(_anyhow_detail::allocate_error<Err>(alloc.resource(), std::forward<Args>(args)...)); }
 }
 
 #endif
@@ -0,0 +1,127 @@
+#ifndef MITAMA_CONCURRENCY_ATOMIC_MAYBE_HPP
+#define MITAMA_CONCURRENCY_ATOMIC_MAYBE_HPP
+
+#include <mitama/result/result.hpp>
+#include <mitama/maybe/maybe.hpp>
+#include <mitama/concurrency/detail/atomic_wait.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace mitama {
+
+/// @brief
+///   Error of `atomic_maybe<T>::try_set`: the value was already set, and the rejected value is handed back.
+template <class T>
+struct already_set {
+  T value;
+};
+
+template <class T>
+already_set(T) -> already_set<T>;
+
+template <class T, class U>
+constexpr auto operator==(already_set<T> const& lhs, already_set<U> const& rhs)
+  -> decltype(lhs.value == rhs.value)
+{
+  return lhs.value == rhs.value;
+}
+
+template <class T, class U>
+constexpr auto operator!=(already_set<T> const& lhs, already_set<U> const& rhs)
+  -> decltype(lhs.value == rhs.value)
+{
+  return !(lhs == rhs);
+}
+
+template <class T>
+auto operator<<(std::ostream& os, already_set<T> const& err)
+  -> decltype(os << err.value)
+{
+  return os << "already_set(" << err.value << ")";
+}
+
+/// @brief
+///   A value published once from one thread to any number of readers.
+///
+/// @note
+///   The first successful `try_set` wins; the value is immutable afterwards and lives until destruction.
+///   `get()` is wait-free: a single acquire load, then a reference to the value.
+///   `wait()` blocks in `std::atomic::wait` (a futex on Linux before C++20) until the value is set.
+template <class T>
+class atomic_maybe {
+  static_assert(std::is_object_v<T> && !std::is_array_v<T>, "atomic_maybe: T must be an object type");
+
+  _concurrency_detail::state_type state_{_concurrency_detail::empty};
+  alignas(T) unsigned char storage_[sizeof(T)];
+
+  T const& stored() const noexcept { return *std::launder(reinterpret_cast<T const*>(storage_)); }
+
+public:
+  atomic_maybe() = default;
+  atomic_maybe(atomic_maybe const&) = delete;
+  atomic_maybe& operator=(atomic_maybe const&) = delete;
+
+  ~atomic_maybe() {
+    if (state_.load(std::memory_order_acquire) == _concurrency_detail::ready) {
+      std::destroy_at(std::launder(reinterpret_cast<T*>(storage_)));
+    }
+  }
+
+  /// @brief
+  ///   Publishes `value` unless a value is already set (or being set by another thread).
+  ///
+  /// @return
+  ///   The published value, or `already_set` holding the rejected `value`.
+  auto try_set(T value) -> result<T const&, already_set<T>> {
+    auto expected = static_cast<std::uint32_t>(_concurrency_detail::empty);
+    if (!state_.compare_exchange_strong(expected, _concurrency_detail::busy,
+                                        std::memory_order_acquire, std::memory_order_relaxed)) {
+      return failure(already_set<T>{std::move(value)});
+    }
+    try {
+      ::new (static_cast<void*>(storage_)) T(std::move(value));
+    }
+    catch (...) {
+      state_.store(_concurrency_detail::empty, std::memory_order_release);
+      _concurrency_detail::notify_all(state_);
+      throw;
+    }
+    state_.store(_concurrency_detail::ready, std::memory_order_release);
+    _concurrency_detail::notify_all(state_);
+    return success(stored());
+  }
+
+  /// @brief
+  ///   The value if it is set, `nothing` otherwise. Never blocks.
+  maybe<T const&> get() const noexcept {
+    if (state_.load(std::memory_order_acquire) == _concurrency_detail::ready) {
+      return just(stored());
+    }
+    return nothing;
+  }
+
+  bool is_set() const noexcept {
+    return state_.load(std::memory_order_acquire) == _concurrency_detail::ready;
+  }
+
+  /// @brief
+  ///   Blocks until the value is set, then returns it.
+  T const& wait() const noexcept {
+    for (auto state = state_.load(std::memory_order_acquire);
+         state != _concurrency_detail::ready;
+         state = state_.load(std::memory_order_acquire)) {
+      _concurrency_detail::wait(state_, state);
+    }
+    return stored();
+  }
+};
+
+}
+
+#endif
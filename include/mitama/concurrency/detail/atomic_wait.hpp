@@ -0,0 +1,45 @@
+#ifndef MITAMA_CONCURRENCY_DETAIL_ATOMIC_WAIT_HPP
+#define MITAMA_CONCURRENCY_DETAIL_ATOMIC_WAIT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if !defined(__cpp_lib_atomic_wait) && defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mitama::_concurrency_detail {
+  /// A state word that threads can block on.
+  using state_type = std::atomic<std::uint32_t>;
+
+  /// States of a value initialized once.
+  enum once_state : std::uint32_t { empty, busy, ready };
+
+  // blocks while `state == old` (spurious wake-ups are allowed)
+  inline void wait(state_type const& state, std::uint32_t old) noexcept {
+#if defined(__cpp_lib_atomic_wait)
+    state.wait(old, std::memory_order_acquire);
+#elif defined(__linux__)
+    static_assert(sizeof(state_type) == sizeof(std::uint32_t));
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t const*>(&state), FUTEX_WAIT_PRIVATE, old, nullptr, nullptr, 0);
+#else
+    if (state.load(std::memory_order_acquire) == old) std::this_thread::yield();
+#endif
+  }
+
+  inline void notify_all(state_type& state) noexcept {
+#if defined(__cpp_lib_atomic_wait)
+    state.notify_all();
+#elif defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)state;
+#endif
+  }
+}
+
+#endif
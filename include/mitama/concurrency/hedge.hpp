@@ -0,0 +1,155 @@
+#ifndef MITAMA_CONCURRENCY_HEDGE_HPP
+#define MITAMA_CONCURRENCY_HEDGE_HPP
+
+#include <mitama/result/result.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace mitama {
+
+/// @brief
+///   Passed to the callables of `hedge` and `first_ok` that accept it:
+///   tells a callable that another one already succeeded, so that it can give up early.
+///
+/// @note
+///   Valid during the call it is passed to.
+class cancel_token {
+  std::atomic<bool> const* cancelled_;
+public:
+  explicit cancel_token(std::atomic<bool> const& cancelled) noexcept: cancelled_(&cancelled) {}
+
+  bool is_cancelled() const noexcept { return cancelled_->load(std::memory_order_relaxed); }
+  explicit operator bool() const noexcept { return is_cancelled(); }
+};
+
+}
+
+namespace mitama::_hedge_detail {
+  template <class F>
+  decltype(auto) call(F& f, cancel_token const& token) {
+    if constexpr (std::is_invocable_v<F&, cancel_token const&>) return f(token);
+    else return f();
+  }
+
+  template <class F>
+  using result_of = meta::remove_cvr_t<decltype(call(std::declval<F&>(), std::declval<cancel_token const&>()))>;
+
+  template <class T, class... E>
+  struct race_state {
+    std::mutex mutex;
+    std::condition_variable done;
+    std::optional<T> winner;
+    std::tuple<std::optional<E>...> errors;
+    std::exception_ptr exception;
+    std::size_t failed = 0;
+    std::atomic<bool> cancelled{false};
+  };
+
+  // runs `f` on a detached thread, which keeps the state alive
+  template <std::size_t I, class State, class F>
+  void launch(std::shared_ptr<State> const& state, F&& f) {
+    std::thread([state, f = std::forward<F>(f)]() mutable {
+      try {
+        auto res = call(f, cancel_token{state->cancelled});
+        using res_type = decltype(res);
+        std::lock_guard lock{state->mutex};
+        if (res.is_ok()) {
+          if (!state->winner) {
+            state->winner.emplace(std::get<success_t<typename res_type::ok_type>>(std::move(res).into_storage()).get());
+            state->cancelled.store(true, std::memory_order_relaxed);
+          }
+        }
+        else {
+          std::get<I>(state->errors).emplace(std::get<failure_t<typename res_type::err_type>>(std::move(res).into_storage()).get());
+          ++state->failed;
+        }
+      }
+      catch (...) {
+        std::lock_guard lock{state->mutex};
+        if (!state->exception) state->exception = std::current_exception();
+        ++state->failed;
+      }
+      state->done.notify_all();
+    }).detach();
+  }
+
+  /// Starts `fs...` in order, each one `delay` after the previous (or as soon as all the started ones failed),
+  /// until one succeeds.
+  template <class... F, std::size_t... I>
+  auto race(std::chrono::nanoseconds delay, std::index_sequence<I...>, F&&... fs)
+    -> result<std::common_type_t<typename result_of<std::decay_t<F>>::ok_type...>,
+              std::tuple<typename result_of<std::decay_t<F>>::err_type...>>
+  {
+    static_assert((is_result_v<result_of<std::decay_t<F>>> && ...),
+                  "hedge/first_ok: the callables must return a basic_result");
+    using T = std::common_type_t<typename result_of<std::decay_t<F>>::ok_type...>;
+    using state_type = race_state<T, typename result_of<std::decay_t<F>>::err_type...>;
+    auto state = std::make_shared<state_type>();
+
+    std::size_t launched = 0;
+    auto const finished = [&] { return state->winner || state->failed == launched; };
+    auto const start = [&](auto index, auto&& f) {
+      if (launched != 0) {
+        std::unique_lock lock{state->mutex};
+        if (delay > std::chrono::nanoseconds::zero()) state->done.wait_for(lock, delay, finished);
+        if (state->winner) return;
+      }
+      launch<decltype(index)::value>(state, std::forward<decltype(f)>(f));
+      ++launched;
+    };
+    (start(std::integral_constant<std::size_t, I>{}, std::forward<F>(fs)), ...);
+
+    std::unique_lock lock{state->mutex};
+    state->done.wait(lock, finished);
+    if (state->winner) {
+      state->cancelled.store(true, std::memory_order_relaxed);
+      return success(std::move(*state->winner));
+    }
+    if (state->exception) std::rethrow_exception(state->exception);
+    return failure(std::apply([](auto&... errors) { return std::tuple(std::move(*errors)...); }, state->errors));
+  }
+}
+
+namespace mitama {
+
+/// @brief
+///   Runs `primary`, and also `backup` if `primary` has not succeeded within `delay`
+///   (or as soon as `primary` failed). Returns the first success, or both failures.
+///
+/// @note
+///   The callables return a `basic_result` (with a common success type), and may take a `cancel_token`.
+///   Each one runs on a detached thread; the one that has not finished when the other succeeds is not waited for,
+///   and its result is discarded. Capture by value what it uses.
+///   If none succeeds and one of them threw, the exception is rethrown.
+template <class Primary, class Backup, class Rep, class Period>
+auto hedge(Primary&& primary, Backup&& backup, std::chrono::duration<Rep, Period> delay) {
+  return _hedge_detail::race(std::chrono::duration_cast<std::chrono::nanoseconds>(delay),
+                             std::index_sequence_for<Primary, Backup>{},
+                             std::forward<Primary>(primary), std::forward<Backup>(backup));
+}
+
+/// @brief
+///   Runs `fs...` concurrently and returns the first success, or the failures of all of them.
+///
+/// @note
+///   Same requirements and behavior as `hedge`, with every callable started at once.
+template <class... F, std::enable_if_t<(sizeof...(F) > 0), bool> = false>
+auto first_ok(F&&... fs) {
+  return _hedge_detail::race(std::chrono::nanoseconds::zero(), std::index_sequence_for<F...>{}, std::forward<F>(fs)...);
+}
+
+}
+
+#endif
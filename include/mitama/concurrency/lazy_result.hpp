@@ -0,0 +1,167 @@
+#ifndef MITAMA_CONCURRENCY_LAZY_RESULT_HPP
+#define MITAMA_CONCURRENCY_LAZY_RESULT_HPP
+
+#include <mitama/result/result.hpp>
+#include <mitama/concurrency/detail/atomic_wait.hpp>
+#include <mitama/mitamagic/noinline.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace mitama {
+
+/// @brief
+///   Whether `lazy_result` keeps a failure of its initializer.
+enum class lazy_policy : std::uint8_t {
+  /// the first result, success or failure, is kept
+  cache_failure,
+  /// a failure is returned to the accessing threads, and the initializer runs again on the next access
+  retry_failure,
+};
+
+/// @brief
+///   A `result<T, E>` computed on first access by a fallible initializer, at most once at a time.
+///
+/// @note
+///   Once initialized, `get()` is a single acquire load (no `std::call_once`, no lock).
+///   Threads accessing it during the initialization block (in `std::atomic::wait`, or a futex on Linux
+///   before C++20) and share its result.
+///   With `lazy_policy::retry_failure`, a failure is also shared with the threads that were waiting for it,
+///   and only later accesses run the initializer again.
+///   An exception thrown by the initializer propagates to its caller, and the next access runs it again.
+template <class T, class E, class F = std::function<result<T, E>()>>
+class lazy_result {
+  static_assert(std::is_object_v<T> && std::is_object_v<E>, "lazy_result: T and E must be object types");
+  static_assert(is_result_v<meta::remove_cvr_t<std::invoke_result_t<F&>>>, "lazy_result: the initializer must return a basic_result");
+
+  // the low bits of the state word are a `once_state`,
+  // the high bits count the failed runs (with `lazy_policy::retry_failure`)
+  static constexpr std::uint32_t state_mask = 0b11;
+  static constexpr std::uint32_t failed_run = 0b100;
+
+  _concurrency_detail::state_type state_{_concurrency_detail::empty};
+  alignas(result<T, E>) unsigned char storage_[sizeof(result<T, E>)];
+  lazy_policy policy_;
+  F init_;
+  // the failure of the last failed run, for the threads that waited for it
+  std::mutex failure_mutex_;
+  std::optional<E> last_failure_;
+
+  static bool is_ready(std::uint32_t state) noexcept {
+    return (state & state_mask) == _concurrency_detail::ready;
+  }
+
+  result<T, E> const& stored() const noexcept {
+    return *std::launder(reinterpret_cast<result<T, E> const*>(storage_));
+  }
+
+  // without the panicking paths of unwrap(), so that the fast path of get() inlines
+  static result<T const&, E> view(result<T, E> const& res) {
+    auto const& storage = res.into_storage();
+    if (auto ok = std::get_if<success_t<T>>(&storage)) return result<T const&, E>{in_place_ok, ok->get()};
+    return result<T const&, E>{in_place_err, std::get_if<failure_t<E>>(&storage)->get()};
+  }
+
+  MITAMA_NOINLINE result<T const&, E> initialize() {
+    auto state = state_.load(std::memory_order_acquire);
+    for (;;) {
+      if (is_ready(state)) return view(stored());
+      if ((state & state_mask) == _concurrency_detail::busy) {
+        auto const waited = state;
+        do {
+          _concurrency_detail::wait(state_, waited);
+          state = state_.load(std::memory_order_acquire);
+        } while (state == waited);
+        if (is_ready(state)) return view(stored());
+        if ((state & ~state_mask) != (waited & ~state_mask)) {
+          // the run we waited for failed
+          std::lock_guard lock{failure_mutex_};
+          return result<T const&, E>{in_place_err, *last_failure_};
+        }
+        continue;
+      }
+      if (state_.compare_exchange_weak(state, (state & ~state_mask) | _concurrency_detail::busy,
+                                       std::memory_order_acquire, std::memory_order_acquire)) {
+        break;
+      }
+    }
+
+    struct guard {
+      _concurrency_detail::state_type& state;
+      std::uint32_t next;
+      ~guard() {
+        state.store(next, std::memory_order_release);
+        _concurrency_detail::notify_all(state);
+      }
+    } done{state_, state};
+
+    result<T, E> res = std::invoke(init_);
+    if (res.is_err() && policy_ == lazy_policy::retry_failure) {
+      {
+        std::lock_guard lock{failure_mutex_};
+        last_failure_.emplace(res.unwrap_err());
+      }
+      done.next = (state & ~state_mask) + failed_run;
+      return failure(res.unwrap_err());
+    }
+    ::new (static_cast<void*>(storage_)) result<T, E>(std::move(res));
+    done.next = _concurrency_detail::ready;
+    return view(stored());
+  }
+
+public:
+  explicit lazy_result(F init, lazy_policy policy = lazy_policy::cache_failure)
+    : policy_(policy), init_(std::move(init)) {}
+
+  lazy_result(lazy_result const&) = delete;
+  lazy_result& operator=(lazy_result const&) = delete;
+
+  ~lazy_result() {
+    if (is_ready(state_.load(std::memory_order_acquire))) {
+      std::destroy_at(std::launder(reinterpret_cast<result<T, E>*>(storage_)));
+    }
+  }
+
+  /// @brief
+  ///   The result of the initializer, running it if it has not run yet
+  ///   (or if it failed, with `lazy_policy::retry_failure`).
+  ///
+  /// @return
+  ///   A reference to the kept success value, or a copy of the failure.
+  result<T const&, E> get() {
+    if (is_ready(state_.load(std::memory_order_acquire))) {
+      return view(stored());
+    }
+    return initialize();
+  }
+
+  /// @brief
+  ///   Whether a result is kept, i.e. `get()` will not run the initializer.
+  bool is_initialized() const noexcept {
+    return is_ready(state_.load(std::memory_order_acquire));
+  }
+};
+
+template <class F>
+lazy_result(F) -> lazy_result<
+  typename meta::remove_cvr_t<std::invoke_result_t<F&>>::ok_type,
+  typename meta::remove_cvr_t<std::invoke_result_t<F&>>::err_type,
+  F>;
+
+template <class F>
+lazy_result(F, lazy_policy) -> lazy_result<
+  typename meta::remove_cvr_t<std::invoke_result_t<F&>>::ok_type,
+  typename meta::remove_cvr_t<std::invoke_result_t<F&>>::err_type,
+  F>;
+
+}
+
+#endif
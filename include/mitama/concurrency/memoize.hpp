@@ -0,0 +1,298 @@
+#ifndef MITAMA_CONCURRENCY_MEMOIZE_HPP
+#define MITAMA_CONCURRENCY_MEMOIZE_HPP
+
+#include <mitama/result/result.hpp>
+#include <mitama/maybe/maybe.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mitama {
+
+/// @brief
+///   Counters of a `memoize` cache, summed over its shards.
+struct memoize_stats {
+  /// calls answered by a cached success
+  std::uint64_t hits = 0;
+  /// calls answered by a cached failure
+  std::uint64_t negative_hits = 0;
+  /// calls that ran the function
+  std::uint64_t misses = 0;
+  /// runs of the function that returned a failure
+  std::uint64_t errors = 0;
+  /// calls that waited for the run of another thread for the same key
+  std::uint64_t coalesced = 0;
+  /// successes evicted to make room for new ones
+  std::uint64_t evictions = 0;
+};
+
+/// @brief
+///   A thread-safe cache of a fallible function `K -> result<V, E>`.
+///
+///   - Successes are kept up to a capacity, evicting with the CLOCK (second chance) policy.
+///   - Failures are kept separately for `failure_ttl` (negative caching), then computed again.
+///   - Concurrent calls for a key that is being computed wait for that computation
+///     instead of running the function again (single-flight).
+///
+/// @note
+///   Keys are spread over shards, each guarded by its own `std::shared_mutex`:
+///   hits take the lock shared, so readers of a shard do not exclude each other.
+///   The function runs without any lock held.
+///   Results are returned by value; cache `std::shared_ptr<V const>` to share large values.
+template <class K, class V, class E, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class memoize {
+public:
+  using clock = std::chrono::steady_clock;
+  using function_type = std::function<result<V, E>(K const&)>;
+
+private:
+  struct slot {
+    std::optional<std::pair<K, V>> entry;
+    std::atomic<bool> referenced{false};
+  };
+
+  struct negative_entry {
+    E error;
+    clock::time_point expiry;
+  };
+
+  struct alignas(64) shard {
+    mutable std::shared_mutex mutex;
+    // successes: a CLOCK ring of slots, indexed by key
+    std::unique_ptr<slot[]> slots;
+    std::size_t capacity = 0;
+    std::size_t size = 0;
+    std::size_t hand = 0;
+    std::vector<std::size_t> free;
+    std::unordered_map<K, std::size_t, Hash, KeyEqual> index;
+    // failures, until their expiry
+    std::unordered_map<K, negative_entry, Hash, KeyEqual> failures;
+    // computations in progress
+    std::unordered_map<K, std::shared_future<result<V, E>>, Hash, KeyEqual> in_flight;
+
+    std::atomic<std::uint64_t> hits{0}, negative_hits{0}, misses{0}, errors{0}, coalesced{0}, evictions{0};
+  };
+
+  function_type function_;
+  clock::duration failure_ttl_;
+  std::unique_ptr<shard[]> shards_;
+  unsigned shard_bits_;
+
+  shard& shard_of(std::size_t hash) const noexcept {
+    // fibonacci hashing: the high bits of the product select the shard, whatever the quality of `Hash`
+    // (split in two shifts, so that a single shard needs no shift by 64)
+    return shards_[static_cast<std::size_t>((std::uint64_t{hash} * 0x9E3779B97F4A7C15ull) >> 1 >> (63 - shard_bits_))];
+  }
+
+  // requires the lock of `s`, shared or exclusive
+  maybe<result<V, E>> lookup(shard& s, K const& key) const {
+    if (auto it = s.index.find(key); it != s.index.end()) {
+      auto& hit = s.slots[it->second];
+      if (!hit.referenced.load(std::memory_order_relaxed)) hit.referenced.store(true, std::memory_order_relaxed);
+      s.hits.fetch_add(1, std::memory_order_relaxed);
+      return just(result<V, E>{in_place_ok, hit.entry->second});
+    }
+    // the clock is read only for keys that have failed
+    if (auto it = s.failures.find(key); it != s.failures.end() && clock::now() < it->second.expiry) {
+      s.negative_hits.fetch_add(1, std::memory_order_relaxed);
+      return just(result<V, E>{in_place_err, it->second.error});
+    }
+    return nothing;
+  }
+
+  // requires the exclusive lock of `s`
+  void insert(shard& s, K const& key, V const& value) {
+    if (auto it = s.index.find(key); it != s.index.end()) {
+      s.slots[it->second].entry->second = value;
+      return;
+    }
+    std::size_t i;
+    if (!s.free.empty()) {
+      i = s.free.back();
+      s.free.pop_back();
+    }
+    else if (s.size < s.capacity) {
+      i = s.size++;
+    }
+    else {
+      // second chance: clear the reference bits until an unreferenced slot comes under the hand
+      while (s.slots[s.hand].referenced.exchange(false, std::memory_order_relaxed)) {
+        s.hand = (s.hand + 1) % s.capacity;
+      }
+      i = s.hand;
+      s.hand = (s.hand + 1) % s.capacity;
+      s.index.erase(s.slots[i].entry->first);
+      s.slots[i].entry.reset();
+      s.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    s.slots[i].entry.emplace(key, value);
+    s.slots[i].referenced.store(false, std::memory_order_relaxed);
+    s.index.emplace(key, i);
+  }
+
+  // requires the exclusive lock of `s`
+  void insert_failure(shard& s, K const& key, E const& error, clock::time_point now) {
+    if (failure_ttl_ <= clock::duration::zero()) return;
+    if (s.failures.size() >= s.capacity && s.failures.find(key) == s.failures.end()) {
+      for (auto it = s.failures.begin(); it != s.failures.end();) {
+        it = now < it->second.expiry ? std::next(it) : s.failures.erase(it);
+      }
+      if (s.failures.size() >= s.capacity) s.failures.erase(s.failures.begin());
+    }
+    s.failures.insert_or_assign(key, negative_entry{error, now + failure_ttl_});
+  }
+
+public:
+  /// @param function: the function to memoize
+  /// @param capacity: the number of successes kept, split evenly over the shards
+  ///                   (leave some headroom: a shard evicts once its own share is full)
+  /// @param failure_ttl: how long a failure is kept; failures are not cached if it is not positive
+  /// @param shards: the number of shards (rounded up to a power of two)
+  memoize(function_type function, std::size_t capacity, clock::duration failure_ttl, std::size_t shards = 16)
+    : function_(std::move(function)), failure_ttl_(failure_ttl)
+  {
+    shard_bits_ = 0;
+    while ((std::size_t{1} << shard_bits_) < shards) ++shard_bits_;
+    auto const count = shard_count();
+    auto const per_shard = std::max<std::size_t>((capacity + count - 1) / count, 1);
+    shards_ = std::make_unique<shard[]>(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      shards_[i].slots = std::make_unique<slot[]>(per_shard);
+      shards_[i].capacity = per_shard;
+    }
+  }
+
+  memoize(memoize const&) = delete;
+  memoize& operator=(memoize const&) = delete;
+
+  /// @brief
+  ///   The cached result for `key`, or the result of the function (shared with concurrent calls for `key`).
+  ///
+  /// @note
+  ///   An exception thrown by the function (or by copying its result) is rethrown to every waiting caller,
+  ///   and the next call for `key` runs the function again.
+  result<V, E> operator()(K const& key) {
+    auto& s = shard_of(Hash{}(key));
+    {
+      std::shared_lock lock{s.mutex};
+      if (auto cached = lookup(s, key)) return std::move(cached).unwrap();
+    }
+
+    std::promise<result<V, E>> promise;
+    {
+      std::unique_lock lock{s.mutex};
+      if (auto cached = lookup(s, key)) return std::move(cached).unwrap();
+      if (auto it = s.in_flight.find(key); it != s.in_flight.end()) {
+        auto pending = it->second;
+        s.coalesced.fetch_add(1, std::memory_order_relaxed);
+        lock.unlock();
+        return pending.get();
+      }
+      s.in_flight.emplace(key, promise.get_future().share());
+      s.misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // until the promise is satisfied, an exception (from the function, or from caching or copying its result)
+    // is handed to the waiting callers, and the key is no longer in flight
+    bool registered = true;
+    bool satisfied = false;
+    try {
+      result<V, E> computed = function_(key);
+      {
+        std::unique_lock lock{s.mutex};
+        registered = false;
+        s.in_flight.erase(key);
+        if (computed.is_ok()) {
+          insert(s, key, computed.unwrap());
+          s.failures.erase(key);
+        }
+        else {
+          insert_failure(s, key, computed.unwrap_err(), clock::now());
+          s.errors.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      promise.set_value(computed);
+      satisfied = true;
+      return computed;
+    }
+    catch (...) {
+      if (registered) {
+        std::unique_lock lock{s.mutex};
+        s.in_flight.erase(key);
+      }
+      if (!satisfied) promise.set_exception(std::current_exception());
+      throw;
+    }
+  }
+
+  /// @brief
+  ///   Drops the cached success or failure for `key`.
+  void invalidate(K const& key) {
+    auto& s = shard_of(Hash{}(key));
+    std::unique_lock lock{s.mutex};
+    if (auto it = s.index.find(key); it != s.index.end()) {
+      s.slots[it->second].entry.reset();
+      s.free.push_back(it->second);
+      s.index.erase(it);
+    }
+    s.failures.erase(key);
+  }
+
+  /// @brief
+  ///   Drops every cached success and failure. Counters are kept.
+  void clear() {
+    for (std::size_t i = 0; i < shard_count(); ++i) {
+      auto& s = shards_[i];
+      std::unique_lock lock{s.mutex};
+      for (std::size_t j = 0; j < s.size; ++j) s.slots[j].entry.reset();
+      s.size = s.hand = 0;
+      s.free.clear();
+      s.index.clear();
+      s.failures.clear();
+    }
+  }
+
+  /// @brief
+  ///   Number of cached successes.
+  std::size_t size() const {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < shard_count(); ++i) {
+      std::shared_lock lock{shards_[i].mutex};
+      n += shards_[i].index.size();
+    }
+    return n;
+  }
+
+  std::size_t shard_count() const noexcept { return std::size_t{1} << shard_bits_; }
+
+  memoize_stats stats() const noexcept {
+    memoize_stats total;
+    for (std::size_t i = 0; i < shard_count(); ++i) {
+      auto const& s = shards_[i];
+      total.hits += s.hits.load(std::memory_order_relaxed);
+      total.negative_hits += s.negative_hits.load(std::memory_order_relaxed);
+      total.misses += s.misses.load(std::memory_order_relaxed);
+      total.errors += s.errors.load(std::memory_order_relaxed);
+      total.coalesced += s.coalesced.load(std::memory_order_relaxed);
+      total.evictions += s.evictions.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+};
+
+}
+
+#endif
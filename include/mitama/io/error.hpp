@@ -0,0 +1,64 @@
+#ifndef MITAMA_IO_ERROR_HPP
+#define MITAMA_IO_ERROR_HPP
+
+#include <mitama/sys_error.hpp>
+
+#include <cstdint>
+#include <ostream>
+#include <system_error>
+#include <type_traits>
+
+namespace mitama::io {
+
+/// @brief
+///   The system call an `io_error` comes from.
+enum class io_operation : std::uint8_t {
+  open, close, read, write, stat, map,
+};
+
+constexpr char const* to_string(io_operation op) noexcept {
+  switch (op) {
+    case io_operation::open: return "open";
+    case io_operation::close: return "close";
+    case io_operation::read: return "read";
+    case io_operation::write: return "write";
+    case io_operation::stat: return "stat";
+    case io_operation::map: return "mmap";
+  }
+  return "";
+}
+
+/// @brief
+///   Error of the `mitama::io` functions: the `errno` value and the failed operation.
+///
+/// @note
+///   Trivially copyable and 8 bytes; the message is only looked up when printed.
+struct io_error {
+  int code;
+  io_operation op;
+
+  /// @brief
+  ///   `code` as a `sys_error`.
+  constexpr sys_error error() const noexcept { return sys_error{code}; }
+
+  /// @brief
+  ///   `code` as a `std::error_code` of the system category.
+  std::error_code error_code() const noexcept { return error().error_code(); }
+
+  friend constexpr bool operator==(io_error const& lhs, io_error const& rhs) noexcept {
+    return lhs.code == rhs.code && lhs.op == rhs.op;
+  }
+  friend constexpr bool operator!=(io_error const& lhs, io_error const& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, io_error const& err) {
+    return os << to_string(err.op) << ": " << err.error();
+  }
+};
+
+static_assert(std::is_trivially_copyable_v<io_error>);
+
+}
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef MITAMA_IO_IO_HPP
+#define MITAMA_IO_IO_HPP
+#include <mitama/result/result.hpp>
+#include <mitama/io/error.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#if __has_include(<span>)
+#include <span>
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/// POSIX I/O returning results.
+///
+/// Every function reports `errno` as `failure(io_error{errno, operation})` instead of a return code;
+/// calls interrupted by a signal (`EINTR`) are retried, and short reads and writes are continued.
+namespace mitama::_io_detail {
+  /// calls `f` until it does not fail with EINTR
+  template <class F>
+  auto retry(F f) {
+    decltype(f()) ret;
+    do { ret = f(); } while (ret == -1 && errno == EINTR);
+    return ret;
+  }
+
+  inline auto failed(io::io_operation op) noexcept {
+    return failure(io::io_error{errno, op});
+  }
+}
+
+namespace mitama::io {
+
+/// @brief
+///   An owned file descriptor, closed on destruction.
+class file {
+  int fd_ = -1;
+public:
+  file() = default;
+  explicit file(int fd) noexcept: fd_(fd) {}
+  file(file&& other) noexcept: fd_(std::exchange(other.fd_, -1)) {}
+  file& operator=(file&& other) noexcept {
+    if (this != &other) {
+      reset();
+      fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+  }
+  file(file const&) = delete;
+  file& operator=(file const&) = delete;
+  ~file() { reset(); }
+
+  int native_handle() const noexcept { return fd_; }
+  explicit operator bool() const noexcept { return fd_ != -1; }
+
+  /// @brief
+  ///   Gives up the ownership of the file descriptor.
+  int release() noexcept { return std::exchange(fd_, -1); }
+
+  /// @brief
+  ///   Closes the file, reporting the error that the destructor ignores.
+  auto close() -> result<void, io_error> {
+    // the descriptor is released even if close fails: retrying could close a reused descriptor
+    if (::close(release()) == -1)
+      return _io_detail::failed(io_operation::close);
+    return success();
+  }
+
+private:
+  void reset() noexcept {
+    if (fd_ != -1) ::close(release());
+  }
+};
+
+/// @brief
+///   A read-only memory mapping of a whole file, unmapped on destruction.
+class mapped_view {
+  std::byte const* data_ = nullptr;
+  std::size_t size_ = 0;
+
+  friend auto map_file(file const&) -> result<mapped_view, io_error>;
+  mapped_view(std::byte const* data, std::size_t size) noexcept: data_(data), size_(size) {}
+
+public:
+  mapped_view() = default;
+  mapped_view(mapped_view&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+  mapped_view& operator=(mapped_view&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+  mapped_view(mapped_view const&) = delete;
+  mapped_view& operator=(mapped_view const&) = delete;
+  ~mapped_view() { unmap(); }
+
+  std::byte const* data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  std::byte const* begin() const noexcept { return data_; }
+  std::byte const* end() const noexcept { return data_ + size_; }
+
+  /// @brief
+  ///   The contents as characters.
+  std::string_view str() const noexcept { return {reinterpret_cast<char const*>(data_), size_}; }
+
+#if defined(__cpp_lib_span)
+  /// @brief
+  ///   The contents as a span, without copy.
+  std::span<std::byte const> bytes() const noexcept { return {data_, size_}; }
+  operator std::span<std::byte const>() const noexcept { return bytes(); }
+#endif
+
+private:
+  void unmap() noexcept {
+    if (data_ != nullptr) ::munmap(const_cast<std::byte*>(data_), size_);
+  }
+};
+
+/// @brief
+///   Opens `path` with the `open(2)` flags `flags` (`O_CLOEXEC` is always added).
+inline auto open_file(char const* path, int flags = O_RDONLY, ::mode_t mode = 0644) -> result<file, io_error> {
+  int fd = _io_detail::retry([&]{ return ::open(path, flags | O_CLOEXEC, mode); });
+  if (fd == -1) return _io_detail::failed(io_operation::open);
+  return success(file{fd});
+}
+
+inline auto open_file(std::string const& path, int flags = O_RDONLY, ::mode_t mode = 0644) -> result<file, io_error> {
+  return open_file(path.c_str(), flags, mode);
+}
+
+/// @brief
+///   Reads up to `count` bytes at `offset`, continuing short reads.
+///
+/// @return
+///   The number of bytes read: less than `count` only at end of file.
+inline auto pread(file const& f, void* buf, std::size_t count, std::uint64_t offset) -> result<std::size_t, io_error> {
+  auto p = static_cast<char*>(buf);
+  std::size_t done = 0;
+  while (done < count) {
+    auto n = _io_detail::retry([&]{ return ::pread(f.native_handle(), p + done, count - done, static_cast<::off_t>(offset + done)); });
+    if (n == -1) return _io_detail::failed(io_operation::read);
+    if (n == 0) break;
+    done += static_cast<std::size_t>(n);
+  }
+  return success(done);
+}
+
+/// @brief
+///   Writes `count` bytes at `offset`, continuing partial writes.
+///
+/// @note
+///   A write that makes no progress (returns zero) fails with `EIO`.
+inline auto pwrite(file const& f, void const* buf, std::size_t count, std::uint64_t offset) -> result<void, io_error> {
+  auto p = static_cast<char const*>(buf);
+  std::size_t done = 0;
+  while (done < count) {
+    auto n = _io_detail::retry([&]{ return ::pwrite(f.native_handle(), p + done, count - done, static_cast<::off_t>(offset + done)); });
+    if (n == -1) return _io_detail::failed(io_operation::write);
+    // nothing written, and no error to report: it would never progress
+    if (n == 0) return failure(io_error{EIO, io_operation::write});
+    done += static_cast<std::size_t>(n);
+  }
+  return success();
+}
+
+/// @brief
+///   Writes `count` bytes at the current position, continuing partial writes.
+///
+/// @note
+///   A write that makes no progress (returns zero) fails with `EIO`.
+inline auto write_all(file const& f, void const* buf, std::size_t count) -> result<void, io_error> {
+  auto p = static_cast<char const*>(buf);
+  std::size_t done = 0;
+  while (done < count) {
+    auto n = _io_detail::retry([&]{ return ::write(f.native_handle(), p + done, count - done); });
+    if (n == -1) return _io_detail::failed(io_operation::write);
+    // nothing written, and no error to report: it would never progress
+    if (n == 0) return failure(io_error{EIO, io_operation::write});
+    done += static_cast<std::size_t>(n);
+  }
+  return success();
+}
+
+inline auto write_all(file const& f, std::string_view str) -> result<void, io_error> {
+  return write_all(f, str.data(), str.size());
+}
+
+/// @brief
+///   Reads from the current position to the end of file.
+///
+/// @note
+///   The buffer is sized from `fstat` for regular files, so that they are read without reallocation.
+inline auto read_all(file const& f) -> result<std::vector<std::byte>, io_error> {
+  struct ::stat st;
+  if (::fstat(f.native_handle(), &st) == -1) return _io_detail::failed(io_operation::stat);
+
+  std::vector<std::byte> buf(S_ISREG(st.st_mode) && st.st_size > 0 ? static_cast<std::size_t>(st.st_size) + 1 : 4096);
+  std::size_t done = 0;
+  for (;;) {
+    if (done == buf.size()) buf.resize(buf.size() * 2);
+    auto n = _io_detail::retry([&]{ return ::read(f.native_handle(), buf.data() + done, buf.size() - done); });
+    if (n == -1) return _io_detail::failed(io_operation::read);
+    if (n == 0) break;
+    done += static_cast<std::size_t>(n);
+  }
+  buf.resize(done);
+  return success(std::move(buf));
+}
+
+inline auto read_all(char const* path) -> result<std::vector<std::byte>, io_error> {
+  return open_file(path).and_then([](file const& f) { return read_all(f); });
+}
+
+inline auto read_all(std::string const& path) -> result<std::vector<std::byte>, io_error> {
+  return read_all(path.c_str());
+}
+
+/// @brief
+///   Maps the whole file read-only, without copying it.
+///
+/// @note
+///   The mapping stays valid after the file is closed.
+///   Only regular files of a known size can be mapped: pipes, devices, and synthesized files
+///   that report a size of zero (e.g. in procfs) fail with `ENODEV`; use `read_all` for them.
+inline auto map_file(file const& f) -> result<mapped_view, io_error> {
+  struct ::stat st;
+  if (::fstat(f.native_handle(), &st) == -1) return _io_detail::failed(io_operation::stat);
+  if (!S_ISREG(st.st_mode)) return failure(io_error{ENODEV, io_operation::map});
+  if (st.st_size == 0) {
+    // mmap rejects empty mappings; the file is empty only if there is nothing to read
+    std::byte probe;
+    auto n = _io_detail::retry([&]{ return ::pread(f.native_handle(), &probe, 1, 0); });
+    if (n == -1) return _io_detail::failed(io_operation::read);
+    if (n != 0) return failure(io_error{ENODEV, io_operation::map});
+    return success(mapped_view{});
+  }
+
+  auto const size = static_cast<std::size_t>(st.st_size);
+  void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, f.native_handle(), 0);
+  if (p == MAP_FAILED) return _io_detail::failed(io_operation::map);
+  return success(mapped_view{static_cast<std::byte const*>(p), size});
+}
+
+inline auto map_file(char const* path) -> result<mapped_view, io_error> {
+  return open_file(path).and_then([](file const& f) { return map_file(f); });
+}
+
+inline auto map_file(std::string const& path) -> result<mapped_view, io_error> {
+  return map_file(path.c_str());
+}
+
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef MITAMA_MAYBE_DICTIONARY_HPP
+#define MITAMA_MAYBE_DICTIONARY_HPP
+#include <mitama/maybe/maybe.hpp>
+#include <mitama/result/detail/meta.hpp>
+#include <mitama/mitamagic/invoke.hpp>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mitama::_dictionary_detail {
+  using std::begin, std::end;
+
+  template <class Dict, class Key, class = void>
+  struct has_find: std::false_type {};
+
+  template <class Dict, class Key>
+  struct has_find<Dict, Key, std::void_t<decltype(std::declval<Dict&>().find(std::declval<Key const&>()))>>
+    : std::true_type {};
+
+  /// `Dict` declares a member named `find`, whatever its signature
+  struct find_probe { void find(); };
+
+  template <class Dict>
+  struct find_detector: Dict, find_probe {};
+
+  template <class Dict, class = void>
+  struct has_find_member: std::true_type {};
+
+  template <class Dict>
+  struct has_find_member<Dict, std::void_t<decltype(&find_detector<Dict>::find)>>: std::false_type {};
+
+  template <class Dict, class = void>
+  struct has_find_member_of_final: std::false_type {};
+
+  template <class Dict>
+  struct has_find_member_of_final<Dict, std::void_t<decltype(&Dict::find)>>: std::true_type {};
+
+  template <class Dict>
+  inline constexpr bool has_find_member_v = std::conditional_t<
+    std::is_class_v<Dict> && !std::is_final_v<Dict>,
+    has_find_member<Dict>, has_find_member_of_final<Dict>>::value;
+
+  /// instantiated when `Dict::find` exists but is not callable with `Key`;
+  /// the diagnostic names both types
+  template <class Dict, class Key>
+  struct find_is_not_callable_with_key {
+    static_assert([]{ return false; }(),
+      "mitama: the dictionary has a `find` member that is not callable with the key type "
+      "(see the template arguments of find_is_not_callable_with_key<Dict, Key>)");
+  };
+
+  template <class Dict, class Key, class = void>
+  struct has_lower_bound: std::false_type {};
+
+  template <class Dict, class Key>
+  struct has_lower_bound<Dict, Key, std::void_t<
+    decltype(std::declval<Dict&>().lower_bound(std::declval<Key const&>())),
+    decltype(std::declval<Dict&>().key_comp())>>
+    : std::true_type {};
+
+  template <class Dict, class Key, class = void>
+  struct has_try_emplace: std::false_type {};
+
+  template <class Dict, class Key>
+  struct has_try_emplace<Dict, Key, std::void_t<decltype(std::declval<Dict&>().try_emplace(std::declval<Key>()))>>
+    : std::true_type {};
+
+  /// the entry of `key`; a single `find` if the dictionary has one, a linear search otherwise
+  ///
+  /// @note
+  ///   Only dictionaries without any `find` member (e.g. sequences of pairs) are searched linearly.
+  ///   A `find` that is not callable with `Key` is a compile error, not a silent O(n) fallback.
+  template <class Dict, class Key>
+  constexpr auto find(Dict& dict, Key const& key) {
+    if constexpr (has_find<Dict, Key>::value) {
+      return std::pair{dict.find(key), end(dict)};
+    }
+    else if constexpr (has_find_member_v<std::remove_const_t<Dict>>) {
+      static_cast<void>(sizeof(find_is_not_callable_with_key<std::remove_const_t<Dict>, Key>));
+      return std::pair{end(dict), end(dict)};
+    }
+    else {
+      auto it = begin(dict);
+      auto last = end(dict);
+      for (; it != last; ++it)
+        if (it->first == key) break;
+      return std::pair{it, last};
+    }
+  }
+
+  /// Looks up the keys one after another.
+  template <class Result, class Dict, class Keys>
+  std::vector<Result> multi_get(Dict& dict, Keys const& keys) {
+    std::vector<Result> out;
+    auto key = begin(keys);
+    auto last = end(keys);
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<decltype(key)>::iterator_category>)
+      out.reserve(static_cast<std::size_t>(std::distance(key, last)));
+
+    for (; key != last; ++key) {
+      auto [it, entries_end] = find(dict, *key);
+      if (it != entries_end)
+        out.emplace_back(std::in_place, it->second);
+      else
+        out.emplace_back();
+    }
+    return out;
+  }
+}
+
+namespace mitama {
+  /// @brief
+  ///   Returns a reference to the value mapped to `key`, or `nothing` if there is no such entry.
+  ///
+  /// @note
+  ///   Looks up with `dict.find(key)` (heterogeneous if the dictionary supports it),
+  ///   falling back to a linear search for dictionaries without `find`.
+  ///   It is a compile error if `dict.find` exists but is not callable with `key`.
+  template <class Dict, class Key,
+    std::enable_if_t<meta::is_dictionary<Dict>::value, bool> = false>
+  constexpr auto get(Dict const& dict, Key const& key)
+    -> maybe<typename Dict::mapped_type const&>
+  {
+    auto [it, last] = _dictionary_detail::find(dict, key);
+    if (it != last) return maybe<typename Dict::mapped_type const&>{std::in_place, it->second};
+    return nothing;
+  }
+
+  /// @brief
+  ///   Returns a mutable reference to the value mapped to `key`, or `nothing` if there is no such entry.
+  template <class Dict, class Key,
+    std::enable_if_t<meta::is_dictionary<Dict>::value && !std::is_const_v<Dict>, bool> = false>
+  constexpr auto get_mut(Dict& dict, Key const& key)
+    -> maybe<typename Dict::mapped_type&>
+  {
+    auto [it, last] = _dictionary_detail::find(dict, key);
+    if (it != last) return maybe<typename Dict::mapped_type&>{std::in_place, it->second};
+    return nothing;
+  }
+
+  /// @brief
+  ///   Returns a mutable reference to the value mapped to `key`,
+  ///   inserting the result of `f()` first if there is no such entry.
+  ///
+  /// @note
+  ///   `f` is invoked only on insertion, and its result is emplaced as is.
+  ///   Ordered dictionaries (with `lower_bound`) are probed once and inserted into with a hint;
+  ///   other dictionaries are probed again on insertion.
+  template <class Dict, class Key, class F,
+    std::enable_if_t<std::conjunction_v<
+      meta::is_dictionary<Dict>,
+      std::negation<std::is_const<Dict>>,
+      std::is_invocable<F&>>, bool> = false>
+  auto get_or_insert_with(Dict& dict, Key&& key, F&& f)
+    -> maybe<typename Dict::mapped_type&>
+  {
+    using mapped_type = typename Dict::mapped_type;
+    if constexpr (_dictionary_detail::has_lower_bound<Dict, Key>::value) {
+      auto hint = dict.lower_bound(key);
+      if (hint != dict.end() && !dict.key_comp()(key, hint->first))
+        return maybe<mapped_type&>{std::in_place, hint->second};
+      return maybe<mapped_type&>{std::in_place,
+        dict.emplace_hint(hint, std::forward<Key>(key), mitamagic::invoke(f))->second};
+    }
+    else {
+      auto [it, last] = _dictionary_detail::find(dict, key);
+      if (it != last) return maybe<mapped_type&>{std::in_place, it->second};
+      if constexpr (_dictionary_detail::has_try_emplace<Dict, Key&&>::value)
+        return maybe<mapped_type&>{std::in_place, dict.try_emplace(std::forward<Key>(key), mitamagic::invoke(f)).first->second};
+      else
+        return maybe<mapped_type&>{std::in_place, dict.emplace(std::forward<Key>(key), mitamagic::invoke(f)).first->second};
+    }
+  }
+
+  /// @brief
+  ///   Looks up every key of `keys`, returning references to the mapped values in the order of `keys`.
+  ///
+  /// @note
+  ///   A batched `find`: each key is looked up as `get` does, one after another.
+  ///   Nothing is prefetched, so the cache misses of a table larger than the cache do not overlap.
+  template <class Dict, class Keys,
+    std::enable_if_t<meta::is_dictionary<Dict>::value, bool> = false>
+  auto multi_get(Dict const& dict, Keys const& keys)
+    -> std::vector<maybe<typename Dict::mapped_type const&>>
+  {
+    return _dictionary_detail::multi_get<maybe<typename Dict::mapped_type const&>>(dict, keys);
+  }
+
+  /// @brief
+  ///   Looks up every key of `keys`, returning mutable references to the mapped values in the order of `keys`.
+  template <class Dict, class Keys,
+    std::enable_if_t<meta::is_dictionary<Dict>::value && !std::is_const_v<Dict>, bool> = false>
+  auto multi_get_mut(Dict& dict, Keys const& keys)
+    -> std::vector<maybe<typename Dict::mapped_type&>>
+  {
+    return _dictionary_detail::multi_get<maybe<typename Dict::mapped_type&>>(dict, keys);
+  }
+}
+
+#endif
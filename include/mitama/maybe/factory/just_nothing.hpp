@@ -9,6 +9,7 @@
 #include <boost/hana/functional/overload_linearly.hpp>
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -102,14 +103,14 @@ public:
         std::is_constructible<T, U&&>,
         std::is_convertible<U&&, T>> = required>
   constexpr just_t(just_t<U> && t) noexcept(std::is_nothrow_constructible_v<T, U>)
-    : x(std::move(t.get())) {}
+    : x(static_cast<U&&>(t.get())) {}
 
   template <typename U,
     where<std::negation<std::is_same<T, U>>,
         std::is_constructible<T, U&&>,
         std::negation<std::is_convertible<U&&, T>>> = required>
   explicit constexpr just_t(just_t<U> && t) noexcept(std::is_nothrow_constructible_v<T, U>)
-    : x(std::move(t.get())) {}
+    : x(static_cast<U&&>(t.get())) {}
 
   template <class... Args,
       where<std::is_constructible<T, Args...>> = required>
@@ -132,11 +133,11 @@ public:
     meta::is_comparable_with<T, U>::value,
   bool>
   operator==(just_t<U> const& rhs) const {
-    return this->x == rhs.get();
+    return this->get() == rhs.get();
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_comparable_with<T, U>::value,
   bool>
@@ -145,7 +146,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_comparable_with<T, U>::value,
   bool>
@@ -169,11 +170,11 @@ public:
     meta::is_comparable_with<T, U>::value,
   bool>
   operator!=(just_t<U> const& rhs) const{
-    return !(this->x == rhs.get());
+    return !(this->get() == rhs.get());
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_comparable_with<T, U>::value,
   bool>
@@ -182,7 +183,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_comparable_with<T, U>::value,
   bool>
@@ -206,11 +207,11 @@ public:
     meta::is_less_comparable_with<T, U>::value,
   bool>
   operator<(just_t<U> const& rhs) const{
-    return this->x < rhs.get();
+    return this->get() < rhs.get();
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_less_comparable_with<T, U>::value,
   bool>
@@ -219,7 +220,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_less_comparable_with<T, U>::value,
   bool>
@@ -245,11 +246,11 @@ public:
       meta::is_comparable_with<T, U>>,
   bool>
   operator<=(just_t<U> const& rhs) const{
-    return this->x < rhs.get() || this->x == rhs.get() ;
+    return this->get() < rhs.get() || this->get() == rhs.get() ;
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     std::conjunction_v<
       meta::is_less_comparable_with<T, U>,
@@ -260,7 +261,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     std::conjunction_v<
       meta::is_less_comparable_with<T, U>,
@@ -281,6 +282,7 @@ public:
   }
 
   template <class U>
+  constexpr
   std::enable_if_t<
     meta::is_comparable_with<T, U>::value,
   bool>
@@ -289,7 +291,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_less_comparable_with<T, U>::value,
   bool>
@@ -298,7 +300,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_less_comparable_with<T, U>::value,
   bool>
@@ -317,6 +319,7 @@ public:
   }
 
   template <class U>
+  constexpr
   std::enable_if_t<
     std::conjunction_v<
       meta::is_less_comparable_with<T, U>,
@@ -327,7 +330,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     std::conjunction_v<
       meta::is_less_comparable_with<T, U>,
@@ -338,7 +341,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     std::conjunction_v<
       meta::is_less_comparable_with<T, U>,
@@ -348,9 +351,9 @@ public:
     return rhs <= lhs;
   }
 
-  T& get() & { return x; }
-  T const& get() const& { return x; }
-  T&& get() && { return std::move(x); }
+  constexpr T& get() & { return x; }
+  constexpr T const& get() const& { return x; }
+  constexpr T&& get() && { return std::move(x); }
 };
 
 template <class T>
@@ -358,7 +361,7 @@ class [[nodiscard]] just_t<T&>
 {
   template <class...> friend class just_t;
 
-  std::reference_wrapper<T> x;
+  T* x;
 
   template <class... Requires>
   using where = std::enable_if_t<std::conjunction_v<Requires...>, std::nullptr_t>;
@@ -372,13 +375,13 @@ public:
 
   constexpr just_t() = delete;
 
-  explicit constexpr just_t(T& ref) : x(ref) {}
-  explicit constexpr just_t(std::in_place_t, T& ref) : x(ref) {}
+  explicit constexpr just_t(T& ref) : x(std::addressof(ref)) {}
+  explicit constexpr just_t(std::in_place_t, T& ref) : x(std::addressof(ref)) {}
 
   template <class Derived, std::enable_if_t<mitamagic::is_interface_of_v<std::decay_t<T>, std::decay_t<Derived>>, bool> = false>
-  explicit constexpr just_t(Derived& derived) : x(derived) {}
+  explicit constexpr just_t(Derived& derived) : x(std::addressof(derived)) {}
   template <class Derived, std::enable_if_t<mitamagic::is_interface_of_v<std::decay_t<T>, std::decay_t<Derived>>, bool> = false>
-  explicit constexpr just_t(std::in_place_t, Derived& derived) : x(derived) {}
+  explicit constexpr just_t(std::in_place_t, Derived& derived) : x(std::addressof(derived)) {}
 
   explicit constexpr just_t(just_t &&) = default;
   explicit constexpr just_t(just_t const&) = default;
@@ -401,11 +404,11 @@ public:
     meta::is_comparable_with<T, U>::value,
   bool>
   operator==(just_t<U> const& rhs) const {
-    return this->x == rhs.get();
+    return this->get() == rhs.get();
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_comparable_with<T, U>::value,
   bool>
@@ -414,7 +417,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_comparable_with<T, U>::value,
   bool>
@@ -438,11 +441,11 @@ public:
     meta::is_comparable_with<T, U>::value,
   bool>
   operator!=(just_t<U> const& rhs) const{
-    return !(this->x == rhs.get());
+    return !(this->get() == rhs.get());
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_comparable_with<T, U>::value,
   bool>
@@ -451,7 +454,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_comparable_with<T, U>::value,
   bool>
@@ -475,11 +478,11 @@ public:
     meta::is_less_comparable_with<T, U>::value,
   bool>
   operator<(just_t<U> const& rhs) const{
-    return this->x < rhs.get();
+    return this->get() < rhs.get();
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_less_comparable_with<T, U>::value,
   bool>
@@ -488,7 +491,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_less_comparable_with<T, U>::value,
   bool>
@@ -514,11 +517,11 @@ public:
       meta::is_comparable_with<T, U>>,
   bool>
   operator<=(just_t<U> const& rhs) const{
-    return this->x < rhs.get() || this->x == rhs.get() ;
+    return this->get() < rhs.get() || this->get() == rhs.get() ;
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     std::conjunction_v<
       meta::is_less_comparable_with<T, U>,
@@ -529,7 +532,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     std::conjunction_v<
       meta::is_less_comparable_with<T, U>,
@@ -550,6 +553,7 @@ public:
   }
 
   template <class U>
+  constexpr
   std::enable_if_t<
     meta::is_comparable_with<T, U>::value,
   bool>
@@ -558,7 +562,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_less_comparable_with<T, U>::value,
   bool>
@@ -567,7 +571,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     meta::is_less_comparable_with<T, U>::value,
   bool>
@@ -586,6 +590,7 @@ public:
   }
 
   template <class U>
+  constexpr
   std::enable_if_t<
     std::conjunction_v<
       meta::is_less_comparable_with<T, U>,
@@ -596,7 +601,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     std::conjunction_v<
       meta::is_less_comparable_with<T, U>,
@@ -607,7 +612,7 @@ public:
   }
 
   template <class U>
-  friend
+  friend constexpr
   std::enable_if_t<
     std::conjunction_v<
       meta::is_less_comparable_with<T, U>,
@@ -617,9 +622,9 @@ public:
     return rhs <= lhs;
   }
 
-  T& get() & { return x.get(); }
-  T const& get() const& { return x.get(); }
-  T& get() && { return x.get(); }
+  constexpr T& get() & { return *x; }
+  constexpr T const& get() const& { return *x; }
+  constexpr T& get() && { return *x; }
 
 };
 
@@ -671,7 +676,7 @@ operator<<(std::ostream& os, just_t<T> const& j) {
 }
 
 template <class Target = void, class... Types>
-auto just(Types&&... v) {
+constexpr auto just(Types&&... v) {
   if constexpr (sizeof...(Types) > 1) {
     return just_t<_just_detail::forward_mode<Target>, Types&&...>{std::forward<Types>(v)...};
   }
@@ -684,7 +689,7 @@ auto just(Types&&... v) {
 }
 
 template <class Target = void, class T, class... Types>
-auto just(std::initializer_list<T> il, Types&&... v) {
+constexpr auto just(std::initializer_list<T> il, Types&&... v) {
   return just_t<_just_detail::forward_mode<Target>, std::initializer_list<T>, Types&&...>{il, std::forward<Types>(v)...};
 }
 
@@ -695,7 +700,7 @@ class [[nodiscard]] just_t<_just_detail::forward_mode<T>, Args...>
 public:
   constexpr explicit just_t(Args... args): args(std::forward<Args>(args)...) {}
 
-  auto operator()() && {
+  constexpr auto operator()() && {
     return std::apply([](auto&&... fwd){ return std::forward_as_tuple(std::forward<decltype(fwd)>(fwd)...); }, args);
   }
 };
@@ -9,6 +9,7 @@
 #include <mitama/result/traits/impl_traits.hpp>
 #include <mitama/maybe/fwd/maybe_fwd.hpp>
 #include <mitama/maybe/factory/just_nothing.hpp>
+#include <mitama/mitamagic/invoke.hpp>
 
 #include <boost/format.hpp>
 #include <boost/hana/functional/fix.hpp>
@@ -69,6 +70,7 @@ template <mutability _, class T, class E>
 class maybe_transpose_injector<maybe<basic_result<_, T, E>>>
 {
 public:
+	constexpr
 	basic_result<_, maybe<T>, E>
 	transpose() const& {
 		return static_cast<maybe<basic_result<_, T, E>>const*>(this)->is_nothing()
@@ -93,7 +95,7 @@ class maybe_unwrap_or_default_injector<maybe<T>,
 			std::is_aggregate<T>>>>
 {
 public:
-  T unwrap_or_default() const
+  constexpr T unwrap_or_default() const
   {
 	if constexpr (std::is_aggregate_v<T>){
 	  return static_cast<maybe<T> const *>(this)->is_just()
@@ -118,10 +120,20 @@ class maybe_flatten_injector<maybe<T>,
 	std::enable_if_t<is_maybe<std::decay_t<T>>::value> >
 {
 public:
-	auto flatten() const& {
-		return static_cast<maybe<T>const*>(this)->is_just()
-			? static_cast<maybe<T>const*>(this)->unwrap().as_ref().cloned()
-			: nothing;
+	constexpr std::decay_t<T> flatten() const& {
+		auto const* self = static_cast<maybe<T>const*>(this);
+		if (self->is_just())
+			return std::get<just_t<T>>(self->storage_).get();
+		else
+			return nothing;
+	}
+
+	constexpr std::decay_t<T> flatten() && {
+		auto* self = static_cast<maybe<T>*>(this);
+		if (self->is_just())
+			return std::get<just_t<T>>(std::move(self->storage_)).get();
+		else
+			return nothing;
 	}
 };
 
@@ -139,7 +151,7 @@ class maybe_cloned_injector<maybe<T>,
 			std::is_copy_constructible<std::remove_const_t<std::remove_reference_t<T>>>>>>
 {
 public:
-	maybe<std::remove_reference_t<T>> cloned() const {
+	constexpr maybe<std::remove_reference_t<T>> cloned() const {
 		auto decay_copy = [](auto&& some) -> std::remove_const_t<std::remove_reference_t<T>> { return std::forward<decltype(some)>(some); };
 		return static_cast<maybe<T>const*>(this)->is_just()
 			? maybe<std::remove_reference_t<T>>{just(decay_copy(static_cast<maybe<T>const*>(this)->unwrap()))}
@@ -149,31 +161,40 @@ public:
 
 template <class, class=void> class maybe_replace_injector {
 public:
-	void cloned() = delete;
+	void replace() = delete;
+	void replace_with() = delete;
 };
 
 template <class T>
-class maybe_replace_injector<maybe<T>, std::enable_if_t<std::is_copy_constructible_v<std::remove_const_t<std::remove_reference_t<T>>>>> {
+class maybe_replace_injector<maybe<T>, std::enable_if_t<std::is_move_constructible_v<T>>> {
 public:
+	/// @brief
+	///   Replaces the contained value by a value constructed from `args`,
+	///   returning the old value (moved out, not cloned) if present.
 	template <class... Args>
+	MITAMA_CXX20_CONSTEXPR
 	std::enable_if_t<
 		std::is_constructible_v<T, Args&&...>,
 	maybe<T>>
 	replace(Args&&... args) & {
-		auto old = static_cast<maybe<T>*>(this)->as_ref().cloned();
+		auto old = static_cast<maybe<T>*>(this)->take();
 		static_cast<maybe<T>*>(this)->storage_.template emplace<just_t<T>>(std::in_place, std::forward<Args>(args)...);
 		return old;
 	}
 
+	/// @brief
+	///   Replaces the contained value by the result of `f(args...)`,
+	///   returning the old value (moved out, not cloned) if present.
 	template <class F, class... Args>
+	MITAMA_CXX20_CONSTEXPR
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F, Args&&...>,
 			std::is_constructible<T, std::invoke_result_t<F&&, Args&&...>>>,
 	maybe<T>>
 	replace_with(F&& f, Args&&... args) & {
-		auto old = static_cast<maybe<T>*>(this)->as_ref().cloned();
-		static_cast<maybe<T>*>(this)->storage_.template emplace<just_t<T>>(std::invoke(std::forward<F>(f), std::forward<Args>(args)...));
+		auto old = static_cast<maybe<T>*>(this)->take();
+		static_cast<maybe<T>*>(this)->storage_.template emplace<just_t<T>>(std::in_place, mitamagic::invoke(std::forward<F>(f), std::forward<Args>(args)...));
 		return old;
 	}
 };
@@ -188,8 +209,13 @@ class maybe
 {
 	std::variant<nothing_t, just_t<T>> storage_;
 	template<class, class> friend class maybe_replace_injector;
+	template<class, class> friend class maybe_flatten_injector;
 	template <class> friend class maybe;
 
+	template <class Tuple, std::size_t... I>
+	constexpr maybe(Tuple&& args, std::index_sequence<I...>)
+		: storage_(std::in_place_type<just_t<T>>, std::in_place, std::get<I>(std::forward<Tuple>(args))...) {}
+
 public:
 	using value_type = std::remove_reference_t<T>;
 	using reference_type = std::add_lvalue_reference_t<value_type>;
@@ -200,7 +226,7 @@ public:
 	maybe& operator=(maybe const&) = default;
 	maybe(maybe&&) = default;
 	maybe& operator=(maybe&&) = default;
-	maybe(nothing_t): maybe() {}
+	constexpr maybe(nothing_t): maybe() {}
 
 	template <typename U,
 		std::enable_if_t<
@@ -208,7 +234,7 @@ public:
 				std::is_constructible<T, U&&>,
 				std::is_convertible<std::decay_t<U>, T>>,
 	bool> = false>
-	maybe(U&& u) : storage_(std::in_place_type<just_t<T>>, std::in_place, std::forward<U>(u)) {}
+	constexpr maybe(U&& u) : storage_(std::in_place_type<just_t<T>>, std::in_place, std::forward<U>(u)) {}
 
 	template <typename U,
 		std::enable_if_t<
@@ -216,82 +242,77 @@ public:
 				std::is_constructible<T, U&&>,
 				std::negation<std::is_convertible<std::decay_t<U>, T>>>,
 	bool> = false>
-	explicit maybe(U&& u) : storage_(std::in_place_type<just_t<T>>, std::in_place, std::forward<U>(u)) {}
+	constexpr explicit maybe(U&& u) : storage_(std::in_place_type<just_t<T>>, std::in_place, std::forward<U>(u)) {}
 
 	template <class... Args,
 		std::enable_if_t<
 			std::is_constructible_v<T, Args&&...>,
 		bool> = false>
-	explicit maybe(std::in_place_t, Args&&... args)
+	constexpr explicit maybe(std::in_place_t, Args&&... args)
 		: storage_(std::in_place_type<just_t<T>>, std::in_place, std::forward<Args>(args)...) {}
 
 	template <class U, class... Args,
 		std::enable_if_t<
 			std::is_constructible_v<T, std::initializer_list<U>, Args&&...>,
 		bool> = false>
-	explicit maybe(std::in_place_t, std::initializer_list<U> il, Args&&... args)
+	constexpr explicit maybe(std::in_place_t, std::initializer_list<U> il, Args&&... args)
 		: storage_(std::in_place_type<just_t<T>>, std::in_place, il, std::forward<Args>(args)...) {}
 
 	template <class... Args,
 		std::enable_if_t<
 			std::is_constructible_v<T, Args...>,
 		bool> = false>
-	maybe(just_t<_just_detail::forward_mode<T>, Args...>&& fwd)
-		: maybe()
-	{
-		std::apply([&](auto&&... args){ storage_.template emplace<just_t<T>>(std::in_place, std::forward<decltype(args)>(args)...); }, std::move(fwd)());
-	}
+	constexpr maybe(just_t<_just_detail::forward_mode<T>, Args...>&& fwd)
+		: maybe(std::move(fwd)(), std::index_sequence_for<Args...>{}) {}
 
 	template <class... Args,
 		std::enable_if_t<
 			std::is_constructible_v<T, Args...>,
 		bool> = false>
-	maybe(just_t<_just_detail::forward_mode<>, Args...>&& fwd)
-		: maybe()
-	{
-		std::apply([&](auto&&... args){ storage_.template emplace<just_t<T>>(std::in_place, std::forward<decltype(args)>(args)...); }, std::move(fwd)());
-	}
+	constexpr maybe(just_t<_just_detail::forward_mode<>, Args...>&& fwd)
+		: maybe(std::move(fwd)(), std::index_sequence_for<Args...>{}) {}
 
 	template <class U,
 		std::enable_if_t<
 			std::is_constructible_v<T, U const&>,
 		bool> = false>
-	maybe(just_t<U> const& j)
+	constexpr maybe(just_t<U> const& j)
 		: storage_(std::in_place_type<just_t<T>>, std::in_place, j.get()) {}
 
 	template <class U,
 		std::enable_if_t<
 			std::is_constructible_v<T, U&&>,
 		bool> = false>
-	maybe(just_t<U>&& j)
+	constexpr maybe(just_t<U>&& j)
 		: storage_(std::in_place_type<just_t<T>>, std::in_place, static_cast<U&&>(j.get())) {}
 
-	explicit operator bool() const {
+	constexpr explicit operator bool() const {
 		return is_just();
 	}
 
-	value_type* operator->() & {
+	constexpr value_type* operator->() & {
 		return &(std::get<just_t<T>>(storage_).get());
 	}
 
-	value_type const* operator->() const& {
+	constexpr value_type const* operator->() const& {
 		return &(std::get<just_t<T>>(storage_).get());
 	}
 
-	bool is_just() const {
+	constexpr bool is_just() const {
 		return std::holds_alternative<just_t<T>>(storage_);
 	}
 
-	bool is_nothing() const {
+	constexpr bool is_nothing() const {
 		return !is_just();
 	}
 
-	value_type& unwrap() & {
+	constexpr value_type& unwrap() & {
 		if (is_nothing())
 			PANIC("called `maybe::unwrap()` on a `nothing` value");
 		return std::get<just_t<T>>(storage_).get();
 	}
 
+	constexpr
 	std::add_const_t<std::remove_reference_t<T>>&
 	unwrap() const& {
 		if (is_nothing())
@@ -299,25 +320,31 @@ public:
 		return std::get<just_t<T>>(storage_).get();
 	}
 
-	value_type unwrap() && {
+	/// @note
+	///   A `maybe<T&>` returns the reference; the referent is not moved from.
+	constexpr std::conditional_t<std::is_reference_v<T>, T, value_type> unwrap() && {
 		if (is_nothing())
 			PANIC("called `maybe::unwrap()` on a `nothing` value");
-		return std::move(std::get<just_t<T>>(storage_).get());
+		if constexpr (std::is_reference_v<T>)
+			return std::get<just_t<T>>(storage_).get();
+		else
+			return std::move(std::get<just_t<T>>(storage_).get());
 	}
 
-	auto as_ref() & {
+	constexpr auto as_ref() & {
 		return is_just()
 			? maybe<T&>(std::in_place, unwrap())
 			: nothing;
 	}
 
-	auto as_ref() const& {
+	constexpr auto as_ref() const& {
 		return is_just()
 			? maybe<const T&>(std::in_place, unwrap())
 			: nothing;
 	}
 
 	template <class... Args>
+	MITAMA_CXX20_CONSTEXPR
 	std::enable_if_t<
 		std::is_constructible_v<T, Args&&...>,
 	value_type&>
@@ -328,6 +355,7 @@ public:
 	}
 
 	template <class F, class... Args>
+	MITAMA_CXX20_CONSTEXPR
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&, Args&&...>,
@@ -336,10 +364,48 @@ public:
 	get_or_emplace_with(F&& f, Args&&... args) & {
 		return is_just()
 			? unwrap()
-			: (storage_.template emplace<just_t<T>>(std::in_place, std::invoke(std::forward<F>(f), std::forward<Args>(args)...)), unwrap());
+			: (storage_.template emplace<just_t<T>>(std::in_place, mitamagic::invoke(std::forward<F>(f), std::forward<Args>(args)...)), unwrap());
+	}
+
+	/// @brief
+	///   Constructs a new value from `args` in place, dropping the old value if any,
+	///   and returns a reference to the new one.
+	template <class... Args>
+	MITAMA_CXX20_CONSTEXPR
+	std::enable_if_t<
+		std::is_constructible_v<T, Args&&...>,
+	value_type&>
+	insert(Args&&... args) & {
+		return storage_.template emplace<just_t<T>>(std::in_place, std::forward<Args>(args)...).get();
+	}
+
+	/// @brief
+	///   Takes the value out of the maybe, leaving a nothing in its place.
+	MITAMA_CXX20_CONSTEXPR maybe take() & {
+		maybe old;
+		if (is_just()) {
+			old.storage_.template emplace<just_t<T>>(std::in_place, std::get<just_t<T>>(std::move(storage_)).get());
+			storage_.template emplace<nothing_t>();
+		}
+		return old;
+	}
+
+	/// @brief
+	///   Takes the value out of the maybe, leaving a nothing in its place,
+	///   but only if the predicate evaluates to true on a mutable reference to the value.
+	template <class P>
+	MITAMA_CXX20_CONSTEXPR
+	std::enable_if_t<
+		std::is_invocable_r_v<bool, P&&, value_type&>,
+	maybe>
+	take_if(P&& pred) & {
+		return is_just() && mitamagic::invoke(std::forward<P>(pred), unwrap())
+			? take()
+			: nothing;
 	}
 
 	template <class U>
+	constexpr
 	std::enable_if_t<
 		meta::has_type<std::common_type<T&, U&&>>::value,
 	std::common_type_t<value_type&, U&&>>
@@ -348,6 +414,7 @@ public:
 	}
 
 	template <class U>
+	constexpr
 	std::enable_if_t<
 		meta::has_type<std::common_type<T const&, U&&>>::value,
 	std::common_type_t<value_type const&, U&&>>
@@ -356,6 +423,7 @@ public:
 	}
 
 	template <class U>
+	constexpr
 	std::enable_if_t<
 		meta::has_type<std::common_type<T&&, U&&>>::value,
 	std::common_type_t<value_type&&, U&&>>
@@ -364,66 +432,70 @@ public:
 	}
 
 	template <class F>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&>,
 			meta::has_type<std::common_type<T&, std::invoke_result_t<F&&>>>>,
 	std::common_type_t<value_type const&, std::invoke_result_t<F&&>>>
 	unwrap_or_else(F&& f) & {
-		return is_just() ? unwrap() : std::invoke(std::forward<F>(f));
+		return is_just() ? unwrap() : mitamagic::invoke(std::forward<F>(f));
 	}
 
 	template <class F>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&>,
 			meta::has_type<std::common_type<T const&, std::invoke_result_t<F&&>>>>,
 	std::common_type_t<value_type const&, std::invoke_result_t<F&&>>>
 	unwrap_or_else(F&& f) const& {
-		return is_just() ? unwrap() : std::invoke(std::forward<F>(f));
+		return is_just() ? unwrap() : mitamagic::invoke(std::forward<F>(f));
 	}
 
 	template <class F>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&>,
 			meta::has_type<std::common_type<T&&, std::invoke_result_t<F&&>>>>,
 	std::common_type_t<value_type const&, std::invoke_result_t<F&&>>>
 	unwrap_or_else(F&& f) && {
-		return is_just() ? std::move(unwrap()) : std::invoke(std::forward<F>(f));
+		return is_just() ? std::move(unwrap()) : mitamagic::invoke(std::forward<F>(f));
 	}
 
 	template <class F, class... Args,
 		std::enable_if_t<
 			std::is_invocable_v<F&&, value_type&, Args&&...>, bool> = false>
-	auto map(F&& f, Args&&... args) & {
+	constexpr auto map(F&& f, Args&&... args) & {
 		using result_type = std::invoke_result_t<F&&, value_type&, Args&&...>;
 		return is_just()
-			? maybe<result_type>{just(std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...))}
+			? maybe<result_type>{just(mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...))}
 			: nothing;
 	}
 
 	template <class F, class... Args,
 		std::enable_if_t<
 			std::is_invocable_v<F&&, value_type const&, Args&&...>, bool> = false>
-	auto map(F&& f, Args&&... args) const& {
+	constexpr auto map(F&& f, Args&&... args) const& {
 		using result_type = std::invoke_result_t<F&&, value_type const&, Args&&...>;
 		return is_just()
-			? maybe<result_type>{just(std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...))}
+			? maybe<result_type>{just(mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...))}
 			: nothing;
 	}
 
 	template <class F, class... Args,
 		std::enable_if_t<
 			std::is_invocable_v<F&&, value_type&&, Args&&...>, bool> = false>
-	auto map(F&& f, Args&&... args) && {
+	constexpr auto map(F&& f, Args&&... args) && {
 		using result_type = std::invoke_result_t<F&&, value_type&&, Args&&...>;
 		return is_just()
-			? maybe<result_type>{just(std::invoke(std::forward<F>(f), std::move(unwrap()), std::forward<Args>(args)...))}
+			? maybe<result_type>{just(mitamagic::invoke(std::forward<F>(f), std::move(unwrap()), std::forward<Args>(args)...))}
 			: nothing;
 	}
 
 	template <class U, class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&, value_type&, Args&&...>,
@@ -431,11 +503,12 @@ public:
 	std::common_type_t<U&&, std::invoke_result_t<F&&, value_type&, Args&&...>>>
 	map_or(U&& def, F&& f, Args&&... args) & {
 		return is_just()
-			? std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
+			? mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
 			: std::forward<U>(def);
 	}
 
 	template <class U, class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&, value_type const&, Args&&...>,
@@ -443,11 +516,12 @@ public:
 	std::common_type_t<U&&, std::invoke_result_t<F&&, T const&, Args&&...>>>
 	map_or(U&& def, F&& f, Args&&... args) const& {
 		return is_just()
-			? std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
+			? mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
 			: std::forward<U>(def);
 	}
 
 	template <class U, class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&, T&&, Args&&...>,
@@ -455,11 +529,12 @@ public:
 	std::common_type_t<U&&, std::invoke_result_t<F&&, value_type&&, Args&&...>>>
 	map_or(U&& def, F&& f, Args&&... args) && {
 		return is_just()
-			? std::invoke(std::forward<F>(f), std::move(unwrap()), std::forward<Args>(args)...)
+			? mitamagic::invoke(std::forward<F>(f), std::move(unwrap()), std::forward<Args>(args)...)
 			: std::forward<U>(def);
 	}
 
 	template <class D, class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<D&&>,
@@ -468,11 +543,12 @@ public:
 	std::common_type_t<std::invoke_result_t<D&&>, std::invoke_result_t<F&&, value_type&, Args&&...>>>
 	map_or_else(D&& def, F&& f, Args&&... args) & {
 		return is_just()
-			? std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
-			: std::invoke(std::forward<D>(def));
+			? mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
+			: mitamagic::invoke(std::forward<D>(def));
 	}
 
 	template <class D, class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<D&&>,
@@ -481,11 +557,12 @@ public:
 	std::common_type_t<std::invoke_result_t<D&&>, std::invoke_result_t<F&&, value_type const&, Args&&...>>>
 	map_or_else(D&& def, F&& f, Args&&... args) const& {
 		return is_just()
-			? std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
-			: std::invoke(std::forward<D>(def));
+			? mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
+			: mitamagic::invoke(std::forward<D>(def));
 	}
 
 	template <class D, class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<D&&>,
@@ -494,11 +571,11 @@ public:
 	std::common_type_t<std::invoke_result_t<D&&>, std::invoke_result_t<F&&, value_type&&, Args&&...>>>
 	map_or_else(D&& def, F&& f, Args&&... args) && {
 		return is_just()
-			? std::invoke(std::forward<F>(f), std::move(unwrap()), std::forward<Args>(args)...)
-			: std::invoke(std::forward<D>(def));
+			? mitamagic::invoke(std::forward<F>(f), std::move(unwrap()), std::forward<Args>(args)...)
+			: mitamagic::invoke(std::forward<D>(def));
 	}
 
-	value_type& expect(std::string_view msg) & {
+	constexpr value_type& expect(std::string_view msg) & {
 		if (is_just()) {
 			return unwrap();
 		}
@@ -507,7 +584,7 @@ public:
 		}
 	}
 
-	value_type const& expect(std::string_view msg) const& {
+	constexpr value_type const& expect(std::string_view msg) const& {
 		if (is_just()) {
 			return unwrap();
 		}
@@ -516,7 +593,7 @@ public:
 		}
 	}
 
-	value_type&& expect(std::string_view msg) && {
+	constexpr value_type&& expect(std::string_view msg) && {
 		if (is_just()) {
 			return std::move(unwrap());
 		}
@@ -526,98 +603,103 @@ public:
 	}
 
 	template <class Pred>
+	constexpr
 	std::enable_if_t<
 		std::is_invocable_r_v<bool, Pred&&, T&>,
 	maybe>
 	filter(Pred&& predicate) & {
-		return is_just() && std::invoke(std::forward<Pred>(predicate), unwrap())
+		return is_just() && mitamagic::invoke(std::forward<Pred>(predicate), unwrap())
 			? maybe<T>(unwrap())
 			: nothing;
 	}
 
 	template <class Pred>
+	constexpr
 	std::enable_if_t<
 		std::is_invocable_r_v<bool, Pred&&, T const&>,
 	maybe>
 	filter(Pred&& predicate) const& {
-		return is_just() && std::invoke(std::forward<Pred>(predicate), unwrap())
+		return is_just() && mitamagic::invoke(std::forward<Pred>(predicate), unwrap())
 			? maybe<T>(unwrap())
 			: nothing;
 	}
 
 	template <class Pred>
+	constexpr
 	std::enable_if_t<
 		std::is_invocable_r_v<bool, Pred&&, T&&>,
 	maybe>
 	filter(Pred&& predicate) && {
-		return is_just() && std::invoke(std::forward<Pred>(predicate), unwrap())
+		return is_just() && mitamagic::invoke(std::forward<Pred>(predicate), unwrap())
 			? maybe<T>(std::move(unwrap()))
 			: nothing;
 	}
 
 	template <class E = std::monostate>
-	auto ok_or(E&& err = {}) & {
+	constexpr auto ok_or(E&& err = {}) & {
 		using ret_t = result<value_type, std::remove_reference_t<E>>;
-		return is_just()
-			? ret_t{success_t{unwrap()}}
-			: ret_t{failure_t{std::forward<E>(std::forward<E>(err))}};
+		if (is_just()) return ret_t{in_place_ok, unwrap()};
+		MITAMA_ERROR_RETURN_TRACE_BEGIN();
+		return ret_t{in_place_err, std::forward<E>(err)};
 	}
 
 	template <class E = std::monostate>
-	auto ok_or(E&& err = {}) const& {
+	constexpr auto ok_or(E&& err = {}) const& {
 		using ret_t = result<value_type, std::remove_reference_t<E>>;
-		return is_just()
-			 ? ret_t{success_t{unwrap()}}
-			 : ret_t{failure_t{std::forward<E>(std::forward<E>(err))}};
+		if (is_just()) return ret_t{in_place_ok, unwrap()};
+		MITAMA_ERROR_RETURN_TRACE_BEGIN();
+		return ret_t{in_place_err, std::forward<E>(err)};
 	}
 
 	template <class E = std::monostate>
-	auto ok_or(E&& err = {}) && {
+	constexpr auto ok_or(E&& err = {}) && {
 		using ret_t = result<value_type, std::remove_reference_t<E>>;
-		return is_just()
-			 ? ret_t{success_t{std::move(unwrap())}}
-			 : ret_t{failure_t{std::forward<E>(std::forward<E>(err))}};
+		if (is_just()) return ret_t{in_place_ok, std::move(unwrap())};
+		MITAMA_ERROR_RETURN_TRACE_BEGIN();
+		return ret_t{in_place_err, std::forward<E>(err)};
 	}
 
 	template <class F>
+	constexpr
 	std::enable_if_t<
 		std::is_invocable_v<F&&>,
 	result<T, std::invoke_result_t<F&&>>>
 	ok_or_else(F&& err) const& {
-		return is_just()
-			? result<T, std::invoke_result_t<F&&>>{success_t{unwrap()}}
-			: result<T, std::invoke_result_t<F&&>>{failure_t{std::invoke(std::forward<F>(err))}};
+		if (is_just()) return result<T, std::invoke_result_t<F&&>>{in_place_ok, unwrap()};
+		MITAMA_ERROR_RETURN_TRACE_BEGIN();
+		return result<T, std::invoke_result_t<F&&>>{in_place_err, mitamagic::invoke(std::forward<F>(err))};
 	}
 
 	template <class F>
+	constexpr
 	std::enable_if_t<
 		std::is_invocable_v<F&&>,
 	result<T, std::invoke_result_t<F&&>>>
 	ok_or_else(F&& err) && {
-		return is_just()
-			? result<T, std::invoke_result_t<F&&>>{success_t{std::move(unwrap())}}
-			: result<T, std::invoke_result_t<F&&>>{failure_t{std::invoke(std::forward<F>(err))}};
+		if (is_just()) return result<T, std::invoke_result_t<F&&>>{in_place_ok, std::move(unwrap())};
+		MITAMA_ERROR_RETURN_TRACE_BEGIN();
+		return result<T, std::invoke_result_t<F&&>>{in_place_err, mitamagic::invoke(std::forward<F>(err))};
 	}
 
 	template <class U>
-	maybe<U> conj(maybe<U> const& rhs) const {
+	constexpr maybe<U> conj(maybe<U> const& rhs) const {
 		return is_just() ? rhs : nothing;
 	}
 
 	template <class U>
-	maybe<U> operator&&(maybe<U> const& rhs) const {
+	constexpr maybe<U> operator&&(maybe<U> const& rhs) const {
 		return this->conj(rhs);
 	}
 
-	maybe<T> disj(maybe<T> const& rhs) const {
+	constexpr maybe<T> disj(maybe<T> const& rhs) const {
 		return is_nothing() ? rhs : *this;
 	}
 
-	maybe<T> operator||(maybe<T> const& rhs) const {
+	constexpr maybe<T> operator||(maybe<T> const& rhs) const {
 		return this->disj(rhs);
 	}
 
-	maybe<T> xdisj(maybe<T> const& rhs) const {
+	constexpr maybe<T> xdisj(maybe<T> const& rhs) const {
 		return is_just() ^ rhs.is_just()
 			? is_just()
         ? *this
@@ -625,11 +707,12 @@ public:
           : nothing;
 	}
 
-	maybe<T> operator^(maybe<T> const& rhs) const {
+	constexpr maybe<T> operator^(maybe<T> const& rhs) const {
 		return this->xdisj(rhs);
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&, T&, Args&&...>,
@@ -637,11 +720,12 @@ public:
 	std::invoke_result_t<F&&, T&, Args&&...>>
 	and_then(F&& f, Args&&... args) & {
 		return is_just()
-			? std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
+			? mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
 			: nothing;
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&, T const&, Args&&...>,
@@ -649,11 +733,12 @@ public:
 	std::invoke_result_t<F&&, T const&, Args&&...>>
 	and_then(F&& f, Args&&... args) const& {
 		return is_just()
-			? std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
+			? mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...)
 			: nothing;
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&, T&&, Args&&...>,
@@ -661,11 +746,12 @@ public:
 	std::invoke_result_t<F&&, T&, Args&&...>>
 	and_then(F&& f, Args&&... args) && {
 		return is_just()
-			? std::invoke(std::forward<F>(f), std::move(unwrap()), std::forward<Args>(args)...)
+			? mitamagic::invoke(std::forward<F>(f), std::move(unwrap()), std::forward<Args>(args)...)
 			: nothing;
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&, Args&&...>,
@@ -674,10 +760,11 @@ public:
 	or_else(F&& f, Args&&... args) & {
 		return is_just()
 			? just(unwrap())
-			: std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+			: mitamagic::invoke(std::forward<F>(f), std::forward<Args>(args)...);
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&, Args&&...>,
@@ -686,10 +773,11 @@ public:
 	or_else(F&& f, Args&&... args) const& {
 		return is_just()
 			? just(unwrap())
-			: std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+			: mitamagic::invoke(std::forward<F>(f), std::forward<Args>(args)...);
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<
 		std::conjunction_v<
 			std::is_invocable<F&&, Args&&...>,
@@ -697,57 +785,62 @@ public:
 	maybe>
 	or_else(F&& f, Args&&... args) && {
 		return is_just()
-			? just(std::move(unwrap()))
-			: std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+			? std::move(*this)
+			: mitamagic::invoke(std::forward<F>(f), std::forward<Args>(args)...);
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<std::is_invocable_v<F&&, value_type&, Args&&...>>
 	and_finally(F&& f, Args&&... args) & {
 		if (is_just())
-			std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...);
+			mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...);
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<std::is_invocable_v<F&&, value_type const&>>
 	and_finally(F&& f, Args&&... args) const& {
 		if (is_just())
-			std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...);
+			mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...);
 	}
 
 	template <class F, class... Args>
-	void and_finally(F&& f, Args&&... args) && {
+	constexpr void and_finally(F&& f, Args&&... args) && {
 		if constexpr (std::is_lvalue_reference_v<T>) {
 			static_assert(std::is_invocable_v<F&&, value_type&, Args&&...>);
 			if (is_just())
-				std::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...);
+				mitamagic::invoke(std::forward<F>(f), unwrap(), std::forward<Args>(args)...);
 		}
 		else {
 			static_assert(std::is_invocable_v<F&&, value_type&&>);
 			if (is_just())
-				std::invoke(std::forward<F>(f), std::move(unwrap()));
+				mitamagic::invoke(std::forward<F>(f), std::move(unwrap()));
 		}
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<std::is_invocable_v<F&&, Args&&...>>
 	or_finally(F&& f, Args&&... args) & {
 		if (is_nothing())
-			std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+			mitamagic::invoke(std::forward<F>(f), std::forward<Args>(args)...);
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<std::is_invocable_v<F&&, Args&&...>>
 	or_finally(F&& f, Args&&... args) const& {
 		if (is_nothing())
-			std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+			mitamagic::invoke(std::forward<F>(f), std::forward<Args>(args)...);
 	}
 
 	template <class F, class... Args>
+	constexpr
 	std::enable_if_t<std::is_invocable_v<F&&, Args&&...>>
 	or_finally(F&& f, Args&&... args) && {
 		if (is_nothing())
-			std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+			mitamagic::invoke(std::forward<F>(f), std::forward<Args>(args)...);
 	}
 
 	template <class F>
@@ -761,16 +854,17 @@ public:
 	{
 		if (is_just()) {
 			if constexpr (std::is_invocable_v<F, value_type&>) {
-				std::invoke(std::forward<F>(f), unwrap());
+				mitamagic::invoke(std::forward<F>(f), unwrap());
 			}
 			else {
-				std::invoke(std::forward<F>(f));
+				mitamagic::invoke(std::forward<F>(f));
 			}
 		}
 		return *this;
 	}
 
 	template <class F>
+	constexpr
 	std::enable_if_t<
 		std::disjunction_v<
 			std::is_invocable<F&&, value_type const&>,
@@ -780,10 +874,10 @@ public:
 	{
 		if (is_just()) {
 			if constexpr (std::is_invocable_v<F, value_type&>) {
-				std::invoke(std::forward<F>(f), unwrap());
+				mitamagic::invoke(std::forward<F>(f), unwrap());
 			}
 			else {
-				std::invoke(std::forward<F>(f));
+				mitamagic::invoke(std::forward<F>(f));
 			}
 		}
 		return *this;
@@ -796,7 +890,7 @@ public:
 	maybe&>
 	or_peek(F&& f) &
 	{
-		if (is_nothing()) std::invoke(std::forward<F>(f));
+		if (is_nothing()) mitamagic::invoke(std::forward<F>(f));
 		return *this;
 	}
 
@@ -807,7 +901,7 @@ public:
 	maybe const&>
 	or_peek(F&& f) const &
 	{
-		if (is_nothing()) std::invoke(std::forward<F>(f));
+		if (is_nothing()) mitamagic::invoke(std::forward<F>(f));
 		return *this;
 	}
 
@@ -817,6 +911,7 @@ template <class T>
 maybe(T&&) -> maybe<T>;
 
 template <class T, class U>
+constexpr
 std::enable_if_t<meta::is_comparable_with<T, U>::value,
 bool>
 operator==(maybe<T> const& lhs, maybe<U> const& rhs) {
@@ -826,16 +921,17 @@ operator==(maybe<T> const& lhs, maybe<U> const& rhs) {
 }
 
 template <class T>
-bool operator==(maybe<T> const& lhs, const nothing_t) {
+constexpr bool operator==(maybe<T> const& lhs, const nothing_t) {
 	return lhs.is_nothing();
 }
 
 template <class T>
-bool operator==(const nothing_t, maybe<T> const& rhs) {
+constexpr bool operator==(const nothing_t, maybe<T> const& rhs) {
 	return rhs.is_nothing();
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<U>>>,
@@ -846,6 +942,7 @@ operator==(maybe<T> const& lhs, U&& rhs) {
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<T>>>,
@@ -857,6 +954,7 @@ operator==(T&& lhs, maybe<U> const& rhs) {
 
 
 template <class T, class U>
+constexpr
 std::enable_if_t<meta::is_comparable_with<T, U>::value,
 bool>
 operator!=(maybe<T> const& lhs, maybe<U> const& rhs) {
@@ -864,16 +962,17 @@ operator!=(maybe<T> const& lhs, maybe<U> const& rhs) {
 }
 
 template <class T>
-bool operator!=(maybe<T> const& lhs, const nothing_t) {
+constexpr bool operator!=(maybe<T> const& lhs, const nothing_t) {
 	return lhs.is_just();
 }
 
 template <class T>
-bool operator!=(const nothing_t, maybe<T> const& rhs) {
+constexpr bool operator!=(const nothing_t, maybe<T> const& rhs) {
 	return rhs.is_just();
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<U>>>,
@@ -884,6 +983,7 @@ operator!=(maybe<T> const& lhs, U&& rhs) {
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<T>>>,
@@ -895,21 +995,24 @@ operator!=(T&& lhs, maybe<U> const& rhs) {
 
 
 template <class T, class U>
-bool operator<(maybe<T> const& lhs, maybe<U> const& rhs) {
-	return lhs.ok_or() < rhs.ok_or();
+constexpr bool operator<(maybe<T> const& lhs, maybe<U> const& rhs) {
+	return lhs.is_just() && rhs.is_just()
+		? lhs.unwrap() < rhs.unwrap()
+		: lhs.is_nothing() && rhs.is_just();
 }
 
 template <class T>
-bool operator<(nothing_t, maybe<T> const& rhs) {
+constexpr bool operator<(nothing_t, maybe<T> const& rhs) {
 	return rhs.is_just();
 }
 
 template <class T>
-bool operator<(maybe<T> const&, nothing_t) {
+constexpr bool operator<(maybe<T> const&, nothing_t) {
 	return false;
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<U>>>,
@@ -920,6 +1023,7 @@ operator<(maybe<T> const& lhs, U&& rhs) {
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<T>>>,
@@ -931,21 +1035,24 @@ operator<(T&& lhs, maybe<U> const& rhs) {
 
 
 template <class T, class U>
-bool operator<=(maybe<T> const& lhs, maybe<U> const& rhs) {
-	return lhs.ok_or() <= rhs.ok_or();
+constexpr bool operator<=(maybe<T> const& lhs, maybe<U> const& rhs) {
+	return lhs.is_just() && rhs.is_just()
+		? (lhs.unwrap() == rhs.unwrap()) || (lhs.unwrap() < rhs.unwrap())
+		: lhs.is_nothing();
 }
 
 template <class T>
-bool operator<=(nothing_t, maybe<T> const&) {
+constexpr bool operator<=(nothing_t, maybe<T> const&) {
 	return true;
 }
 
 template <class T>
-bool operator<=(maybe<T> const& lhs, nothing_t) {
+constexpr bool operator<=(maybe<T> const& lhs, nothing_t) {
 	return lhs.is_nothing();
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<U>>>,
@@ -957,6 +1064,7 @@ operator<=(maybe<T> const& lhs, U&& rhs) {
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<T>>>,
@@ -969,21 +1077,24 @@ operator<=(T&& lhs, maybe<U> const& rhs) {
 
 
 template <class T, class U>
-bool operator>(maybe<T> const& lhs, maybe<U> const& rhs) {
-	return lhs.ok_or() > rhs.ok_or();
+constexpr bool operator>(maybe<T> const& lhs, maybe<U> const& rhs) {
+	return lhs.is_just() && rhs.is_just()
+		? rhs.unwrap() < lhs.unwrap()
+		: lhs.is_just() && rhs.is_nothing();
 }
 
 template <class T>
-bool operator>(nothing_t, maybe<T> const&) {
+constexpr bool operator>(nothing_t, maybe<T> const&) {
 	return false;
 }
 
 template <class T>
-bool operator>(maybe<T> const& lhs, nothing_t) {
+constexpr bool operator>(maybe<T> const& lhs, nothing_t) {
 	return lhs.is_just();
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<U>>>,
@@ -994,6 +1105,7 @@ operator>(maybe<T> const& lhs, U&& rhs) {
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<T>>>,
@@ -1005,21 +1117,24 @@ operator>(T&& lhs, maybe<U> const& rhs) {
 
 
 template <class T, class U>
-bool operator>=(maybe<T> const& lhs, maybe<U> const& rhs) {
-	return lhs.ok_or() >= rhs.ok_or();
+constexpr bool operator>=(maybe<T> const& lhs, maybe<U> const& rhs) {
+	return lhs.is_just() && rhs.is_just()
+		? (lhs.unwrap() == rhs.unwrap()) || (rhs.unwrap() < lhs.unwrap())
+		: rhs.is_nothing();
 }
 
 template <class T>
-bool operator>=(nothing_t, maybe<T> const& rhs) {
+constexpr bool operator>=(nothing_t, maybe<T> const& rhs) {
 	return rhs.is_nothing();
 }
 
 template <class T>
-bool operator>=(maybe<T> const&, nothing_t) {
+constexpr bool operator>=(maybe<T> const&, nothing_t) {
 	return true;
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<U>>>,
@@ -1031,6 +1146,7 @@ operator>=(maybe<T> const& lhs, U&& rhs) {
 }
 
 template <class T, class U>
+constexpr
 std::enable_if_t<
 	std::conjunction_v<
 		std::negation<is_maybe<std::decay_t<T>>>,
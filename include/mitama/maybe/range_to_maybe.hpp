@@ -1,7 +1,11 @@
 #ifndef MITAMA_MAYBE_RANGE_TO_MAYBE_HPP
 #define MITAMA_MAYBE_RANGE_TO_MAYBE_HPP
 #include <mitama/maybe/maybe.hpp>
+#include <mitama/mitamagic/invoke.hpp>
+#include <mitama/result/detail/dangling.hpp>
 #include <boost/hana/functional/overload_linearly.hpp>
+#include <cstddef>
+#include <functional>
 #include <type_traits>
 #include <utility>
 #include <iterator>
@@ -19,6 +23,63 @@ namespace mitama::_range_to_maybe_detail {
   {
     using type = decltype(*begin(std::declval<T>()));
   };
+
+  template <class Range>
+  using iterator_t = decltype(begin(std::declval<Range&>()));
+
+  template <class Range>
+  using reference_t = decltype(*std::declval<iterator_t<Range>&>());
+
+  template <class Range>
+  using value_t = std::remove_cv_t<std::remove_reference_t<reference_t<Range>>>;
+
+  template <class Range, class Tag>
+  inline constexpr bool is_iterator_of_v
+    = std::is_base_of_v<Tag, typename std::iterator_traits<iterator_t<Range>>::iterator_category>;
+
+  /// Elements of forward ranges are borrowed: as `T&` from lvalue ranges,
+  /// and as `dangling<std::reference_wrapper<T>>` from rvalue ranges (which may own their elements).
+  /// Elements of input ranges, and elements yielded by value, are returned by value
+  /// (the reference into an input range is invalidated by the next increment).
+  template <class Range>
+  inline constexpr bool borrows_v
+    = is_iterator_of_v<Range, std::forward_iterator_tag> && std::is_lvalue_reference_v<reference_t<Range>>;
+
+  template <class Range>
+  using element_t =
+    std::conditional_t<!borrows_v<Range>, value_t<Range>,
+    std::conditional_t<std::is_lvalue_reference_v<Range>, reference_t<Range>,
+      dangle_ref<reference_t<Range>>>>;
+
+  template <class Range, class It>
+  constexpr maybe<element_t<Range>> found(It const& it) {
+    if constexpr (borrows_v<Range> && !std::is_lvalue_reference_v<Range>)
+      return maybe<element_t<Range>>{std::in_place, std::ref(*it)};
+    else
+      return maybe<element_t<Range>>{std::in_place, *it};
+  }
+
+  /// best element of a range by `better(candidate, best)`
+  template <class Range, class Better>
+  constexpr maybe<element_t<Range>> select(Range&& range, Better better) {
+    auto it = begin(range);
+    auto last = end(range);
+    if (!(it != last)) return nothing;
+    if constexpr (borrows_v<Range>) {
+      auto best = it;
+      for (++it; it != last; ++it)
+        if (better(*it, *best)) best = it;
+      return found<Range>(best);
+    }
+    else {
+      value_t<Range> best = *it;
+      for (++it; it != last; ++it) {
+        value_t<Range> candidate = *it;
+        if (better(candidate, best)) best = std::move(candidate);
+      }
+      return maybe<element_t<Range>>{std::in_place, std::move(best)};
+    }
+  }
 }
 
 namespace mitama {
@@ -36,6 +97,88 @@ namespace mitama {
       std::forward<Range>(range)
     );
   }
+
+  /// @brief
+  ///   Returns the first element of `range`, or `nothing` if it is empty.
+  ///
+  /// @note
+  ///   Elements of forward ranges are borrowed (`maybe<T&>`) from lvalue ranges,
+  ///   and returned as `maybe<dangling<std::reference_wrapper<T>>>` from rvalue ranges.
+  ///   Elements of input ranges and elements yielded by value are returned by value.
+  template <class Range>
+  constexpr auto first(Range&& range) -> maybe<_range_to_maybe_detail::element_t<Range>> {
+    using std::begin, std::end;
+    auto it = begin(range);
+    if (it != end(range)) return _range_to_maybe_detail::found<Range>(it);
+    return nothing;
+  }
+
+  /// @brief
+  ///   Returns the last element of `range`, or `nothing` if it is empty.
+  ///
+  /// @note
+  ///   Bidirectional ranges are not traversed.
+  template <class Range>
+  constexpr auto last(Range&& range) -> maybe<_range_to_maybe_detail::element_t<Range>> {
+    using std::begin, std::end;
+    using namespace _range_to_maybe_detail;
+    auto it = begin(range);
+    auto sentinel = end(range);
+    if (!(it != sentinel)) return nothing;
+    if constexpr (is_iterator_of_v<Range, std::bidirectional_iterator_tag>
+                  && std::is_same_v<decltype(it), decltype(sentinel)>) {
+      return found<Range>(std::prev(sentinel));
+    }
+    else {
+      return select(std::forward<Range>(range), [](auto const&, auto const&) { return true; });
+    }
+  }
+
+  /// @brief
+  ///   Returns the `n`-th (zero-based) element of `range`, or `nothing` if it has no more than `n` elements.
+  template <class Range>
+  constexpr auto nth(Range&& range, std::size_t n) -> maybe<_range_to_maybe_detail::element_t<Range>> {
+    using std::begin, std::end;
+    using namespace _range_to_maybe_detail;
+    auto it = begin(range);
+    auto sentinel = end(range);
+    if constexpr (is_iterator_of_v<Range, std::random_access_iterator_tag>
+                  && std::is_same_v<decltype(it), decltype(sentinel)>) {
+      if (n < static_cast<std::size_t>(sentinel - it)) return found<Range>(it + n);
+      return nothing;
+    }
+    else {
+      for (; it != sentinel; ++it, --n)
+        if (n == 0) return found<Range>(it);
+      return nothing;
+    }
+  }
+
+  /// @brief
+  ///   Returns the first element of `range` satisfying `pred`, or `nothing` if there is none.
+  template <class Range, class Pred>
+  constexpr auto find_if(Range&& range, Pred&& pred) -> maybe<_range_to_maybe_detail::element_t<Range>> {
+    using std::begin, std::end;
+    for (auto it = begin(range), sentinel = end(range); it != sentinel; ++it)
+      if (mitamagic::invoke(pred, *it)) return _range_to_maybe_detail::found<Range>(it);
+    return nothing;
+  }
+
+  /// @brief
+  ///   Returns the first smallest element of `range` by `comp`, or `nothing` if it is empty.
+  template <class Range, class Compare = std::less<>>
+  constexpr auto min_element(Range&& range, Compare comp = Compare{}) -> maybe<_range_to_maybe_detail::element_t<Range>> {
+    return _range_to_maybe_detail::select(std::forward<Range>(range),
+      [&comp](auto const& candidate, auto const& best) -> bool { return mitamagic::invoke(comp, candidate, best); });
+  }
+
+  /// @brief
+  ///   Returns the first largest element of `range` by `comp`, or `nothing` if it is empty.
+  template <class Range, class Compare = std::less<>>
+  constexpr auto max_element(Range&& range, Compare comp = Compare{}) -> maybe<_range_to_maybe_detail::element_t<Range>> {
+    return _range_to_maybe_detail::select(std::forward<Range>(range),
+      [&comp](auto const& candidate, auto const& best) -> bool { return mitamagic::invoke(comp, best, candidate); });
+  }
 }
 
 #endif
@@ -0,0 +1,201 @@
+#ifndef MITAMA_MEMORY_ARENA_HPP
+#define MITAMA_MEMORY_ARENA_HPP
+
+#include <mitama/result/result.hpp>
+#include <mitama/panic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace mitama {
+
+/// @brief
+///   Error of `arena::try_allocate`: the arena has not enough room left.
+struct arena_exhausted {
+  /// bytes requested (including alignment padding and bookkeeping)
+  std::size_t requested;
+  /// bytes left in the arena
+  std::size_t available;
+
+  friend constexpr bool operator==(arena_exhausted const& lhs, arena_exhausted const& rhs) noexcept {
+    return lhs.requested == rhs.requested && lhs.available == rhs.available;
+  }
+  friend constexpr bool operator!=(arena_exhausted const& lhs, arena_exhausted const& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, arena_exhausted const& err) {
+    return os << "arena exhausted: requested " << err.requested << " bytes, " << err.available << " bytes available";
+  }
+};
+
+/// @brief
+///   A bump allocator over a fixed buffer.
+///
+///   Objects are created with `try_allocate<T>(args...)`, which reports exhaustion as a result.
+///   As a `std::pmr::memory_resource`, it serves allocations from the buffer
+///   and forwards the ones that do not fit to the upstream resource
+///   (`std::pmr::null_memory_resource()` by default, which throws `std::bad_alloc`).
+///   Deallocation of buffer memory is a no-op; `reset()` releases the whole buffer at once.
+///
+/// @note
+///   `reset()` and the destructor run the destructors of the non-trivially destructible objects
+///   created by `try_allocate`, latest first; trivially destructible objects are released in O(1).
+///   Memory handed out as a memory resource must have been deallocated before `reset()` and the destructor.
+class arena final : public std::pmr::memory_resource {
+  struct finalizer {
+    void (*destroy)(void*) noexcept;
+    void* object;
+    finalizer* next;
+  };
+
+  std::unique_ptr<std::byte[]> owned_;
+  std::byte* begin_;
+  std::byte* current_;
+  std::byte* end_;
+  std::pmr::memory_resource* upstream_;
+  finalizer* finalizers_ = nullptr;
+  std::size_t live_ = 0;
+
+  /// bump allocation; nullptr if the buffer has not enough room
+  void* bump(std::size_t bytes, std::size_t align) noexcept {
+    auto const addr = reinterpret_cast<std::uintptr_t>(current_);
+    auto const aligned = (addr + (align - 1)) & ~static_cast<std::uintptr_t>(align - 1);
+    auto const padding = static_cast<std::size_t>(aligned - addr);
+    if (padding > available() || bytes > available() - padding) return nullptr;
+    current_ += padding + bytes;
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  void release() noexcept {
+    for (auto fin = finalizers_; fin != nullptr; fin = fin->next)
+      fin->destroy(fin->object);
+    finalizers_ = nullptr;
+    current_ = begin_;
+  }
+
+  template <class T>
+  static void destroy(void* object) noexcept {
+    static_cast<T*>(object)->~T();
+  }
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    if (void* p = bump(bytes, align)) {
+      ++live_;
+      return p;
+    }
+    return upstream_->allocate(bytes, align);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    if (owns(p)) --live_;
+    else upstream_->deallocate(p, bytes, align);
+  }
+
+  bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+    return this == &other;
+  }
+
+public:
+  /// @brief
+  ///   Creates an arena over a buffer of `capacity` bytes, allocated from the global heap.
+  explicit arena(std::size_t capacity, std::pmr::memory_resource* upstream = std::pmr::null_memory_resource())
+    : owned_(new std::byte[capacity])
+    , begin_(owned_.get()), current_(begin_), end_(begin_ + capacity)
+    , upstream_(upstream) {}
+
+  /// @brief
+  ///   Creates an arena over a caller-provided buffer.
+  arena(void* buffer, std::size_t size, std::pmr::memory_resource* upstream = std::pmr::null_memory_resource()) noexcept
+    : begin_(static_cast<std::byte*>(buffer)), current_(begin_), end_(begin_ + size)
+    , upstream_(upstream) {}
+
+  arena(arena const&) = delete;
+  arena& operator=(arena const&) = delete;
+
+  /// @brief
+  ///   Destroys the objects created by `try_allocate`.
+  ///
+  /// @note
+  ///   Aborts if memory handed out as a memory resource has not been deallocated:
+  ///   it would be used after free, and a destructor cannot panic.
+  ~arena() override {
+    if (live_ != 0) {
+      std::fprintf(stderr, "arena::~arena(): %zu allocations are still alive\n", live_);
+      std::abort();
+    }
+    release();
+  }
+
+  /// @brief
+  ///   Creates a `T` from `args...` in the arena.
+  ///
+  /// @return
+  ///   A reference to the new object, or `arena_exhausted` if it does not fit.
+  ///   The object lives until `reset()`.
+  template <class T, class... Args>
+  auto try_allocate(Args&&... args) -> mut_result<T&, arena_exhausted> {
+    auto const saved = current_;
+    finalizer* fin = nullptr;
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      fin = static_cast<finalizer*>(bump(sizeof(finalizer), alignof(finalizer)));
+    }
+    void* p = (std::is_trivially_destructible_v<T> || fin) ? bump(sizeof(T), alignof(T)) : nullptr;
+    if (p == nullptr) {
+      current_ = saved;
+      auto const bookkeeping = std::is_trivially_destructible_v<T> ? 0 : sizeof(finalizer) + alignof(finalizer) - 1;
+      return failure(arena_exhausted{sizeof(T) + alignof(T) - 1 + bookkeeping, available()});
+    }
+
+    T* object;
+    if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+      object = ::new (p) T(std::forward<Args>(args)...);
+    }
+    else {
+      try { object = ::new (p) T(std::forward<Args>(args)...); }
+      catch (...) { current_ = saved; throw; }
+    }
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      *fin = finalizer{&destroy<T>, object, finalizers_};
+      finalizers_ = fin;
+    }
+    return success(*object);
+  }
+
+  /// @brief
+  ///   Destroys the objects created by `try_allocate` and makes the whole buffer available again.
+  ///
+  /// @panics
+  ///   Panics if memory handed out as a memory resource has not been deallocated.
+  void reset() {
+    if (live_ != 0)
+      PANIC("arena::reset(): %1% allocations are still alive", live_);
+    release();
+  }
+
+  /// @brief
+  ///   Returns true if `p` points into the buffer of this arena.
+  bool owns(void const* p) const noexcept {
+    auto const addr = reinterpret_cast<std::uintptr_t>(p);
+    return reinterpret_cast<std::uintptr_t>(begin_) <= addr && addr < reinterpret_cast<std::uintptr_t>(end_);
+  }
+
+  std::size_t capacity() const noexcept { return static_cast<std::size_t>(end_ - begin_); }
+  std::size_t used() const noexcept { return static_cast<std::size_t>(current_ - begin_); }
+  std::size_t available() const noexcept { return static_cast<std::size_t>(end_ - current_); }
+  /// number of memory resource allocations from the buffer not yet deallocated
+  std::size_t live() const noexcept { return live_; }
+};
+
+}
+
+#endif
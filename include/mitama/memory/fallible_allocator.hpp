@@ -0,0 +1,153 @@
+#ifndef MITAMA_MEMORY_FALLIBLE_ALLOCATOR_HPP
+#define MITAMA_MEMORY_FALLIBLE_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace mitama {
+
+/// @brief
+///   Why a fallible container operation could not allocate.
+enum class alloc_error_kind {
+  /// the requested capacity exceeds `max_size()`
+  capacity_overflow,
+  /// the allocator could not provide the memory
+  allocation_failure,
+};
+
+/// @brief
+///   Error of the `try_*` container operations.
+struct alloc_error {
+  alloc_error_kind kind;
+  /// size of the allocation that failed (zero on capacity overflow)
+  std::size_t bytes;
+
+  friend constexpr bool operator==(alloc_error const& lhs, alloc_error const& rhs) noexcept {
+    return lhs.kind == rhs.kind && lhs.bytes == rhs.bytes;
+  }
+  friend constexpr bool operator!=(alloc_error const& lhs, alloc_error const& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, alloc_error const& err) {
+    if (err.kind == alloc_error_kind::capacity_overflow)
+      return os << "capacity overflow";
+    return os << "memory allocation of " << err.bytes << " bytes failed";
+  }
+};
+
+}
+
+namespace mitama::_fallible_detail {
+  /// A block acquired without throwing by a `try_*` operation,
+  /// handed over to the next `fallible_allocator::allocate` on this thread that it is large enough for.
+  struct stash {
+    void* block = nullptr;
+    std::size_t bytes = 0;
+    std::size_t align = 0;
+    /// size and alignment of the allocation the block did not fit
+    std::size_t required_bytes = 0;
+    std::size_t required_align = 0;
+  };
+
+  /// Thrown by `fallible_allocator::allocate` (instead of allocating with the throwing path)
+  /// when the block of the running `try_*` operation does not fit;
+  /// caught by the operation, which retries with the size recorded in the stash.
+  struct stash_mismatch {};
+
+  // no dynamic initialization nor destructor: allocate() reads it without a TLS init wrapper
+  static_assert(std::is_trivially_destructible_v<stash> && (static_cast<void>(stash{}), true));
+  inline thread_local stash pending{};
+
+  inline void* allocate(std::size_t bytes, std::size_t align) noexcept {
+    if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+      return ::operator new(bytes, std::align_val_t{align}, std::nothrow);
+    return ::operator new(bytes, std::nothrow);
+  }
+
+  inline void deallocate(void* p, std::size_t align) noexcept {
+    if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+      ::operator delete(p, std::align_val_t{align});
+    else
+      ::operator delete(p);
+  }
+
+  /// @brief
+  ///   Acquires `bytes` for the next allocation of this thread, without throwing.
+  ///   Releases the block on destruction if it has not been handed over.
+  class reservation {
+    std::size_t align_;
+  public:
+    reservation(std::size_t bytes, std::size_t align) noexcept: align_(align) {
+      pending = stash{allocate(bytes, align), bytes, align};
+    }
+    reservation(reservation const&) = delete;
+    reservation& operator=(reservation const&) = delete;
+    ~reservation() {
+      if (pending.block != nullptr) deallocate(pending.block, align_);
+      pending = stash{};
+    }
+
+    explicit operator bool() const noexcept { return pending.block != nullptr; }
+  };
+}
+
+namespace mitama {
+
+/// @brief
+///   An allocator whose allocations can be acquired without throwing by the `try_*` container operations
+///   (see `<mitama/memory/fallible_container.hpp>`).
+///   `try_*` acquires the memory up front with the `nothrow` `operator new` and reports failure as a result,
+///   so the container operation itself never runs out of memory.
+///
+/// @note
+///   Outside of `try_*`, it behaves as `std::allocator` (and throws `std::bad_alloc` on failure).
+///   Inside of `try_*`, an allocation the acquired block does not fit is not made;
+///   the operation acquires a block of the observed size and runs again.
+template <class T>
+class fallible_allocator {
+public:
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+  constexpr fallible_allocator() noexcept = default;
+  template <class U>
+  constexpr fallible_allocator(fallible_allocator<U> const&) noexcept {}
+
+  [[nodiscard]] T* allocate(std::size_t n) {
+    auto& pending = _fallible_detail::pending;
+    // the block is released as if allocated for T: the alignment must be of the same kind
+    constexpr bool over_aligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    if (pending.block != nullptr && n <= pending.bytes / sizeof(T)
+        && alignof(T) <= pending.align && over_aligned == (pending.align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)) {
+      return static_cast<T*>(std::exchange(pending, _fallible_detail::stash{}).block);
+    }
+    if (pending.block != nullptr) {
+      pending.required_bytes = n * sizeof(T);
+      pending.required_align = std::max(alignof(T), alignof(std::max_align_t));
+      throw _fallible_detail::stash_mismatch{};
+    }
+    if (void* p = _fallible_detail::allocate(n * sizeof(T), alignof(T))) {
+      return static_cast<T*>(p);
+    }
+    throw std::bad_alloc{};
+  }
+
+  void deallocate(T* p, std::size_t) noexcept {
+    _fallible_detail::deallocate(p, alignof(T));
+  }
+
+  template <class U>
+  friend constexpr bool operator==(fallible_allocator const&, fallible_allocator<U> const&) noexcept { return true; }
+  template <class U>
+  friend constexpr bool operator!=(fallible_allocator const&, fallible_allocator<U> const&) noexcept { return false; }
+};
+
+}
+
+#endif
@@ -0,0 +1,294 @@
+#ifndef MITAMA_MEMORY_FALLIBLE_CONTAINER_HPP
+#define MITAMA_MEMORY_FALLIBLE_CONTAINER_HPP
+
+#include <mitama/result/result.hpp>
+#include <mitama/memory/fallible_allocator.hpp>
+#include <mitama/panic.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <new>
+#include <set>
+#include <type_traits>
+#include <utility>
+
+/// Fallible container operations.
+///
+/// `try_reserve`, `try_resize`, `try_push_back`, `try_emplace_back` and `try_insert`
+/// report allocation failure as `failure(alloc_error{...})` instead of throwing `std::bad_alloc`.
+/// For containers using `fallible_allocator`, the memory is acquired up front without throwing,
+/// so the failure path is a branch; the container is left untouched on failure.
+/// The supported containers are `std::vector`, `std::basic_string`, `std::list`,
+/// `std::map`, `std::multimap`, `std::set` and `std::multiset`: each operation makes at most one allocation.
+/// The node size of node-based containers is observed on their first `try_*` operation
+/// (the allocator reports the size of the rebound node type when the first guess does not fit).
+/// Other containers are supported by catching `std::bad_alloc`.
+namespace mitama::_fallible_detail {
+  template <class Container>
+  using allocator_of = typename Container::allocator_type;
+
+  template <class Container>
+  inline constexpr bool is_fallible_v = std::is_same_v<
+    allocator_of<Container>,
+    fallible_allocator<typename std::allocator_traits<allocator_of<Container>>::value_type>>;
+
+  template <class Container, class = void>
+  struct has_capacity: std::false_type {};
+
+  template <class Container>
+  struct has_capacity<Container, std::void_t<decltype(std::declval<Container const&>().capacity())>>
+    : std::true_type {};
+
+  /// containers that allocate one node per inserted element, and nothing else
+  template <class> struct is_node_sequence: std::false_type {};
+  template <class T, class A> struct is_node_sequence<std::list<T, A>>: std::true_type {};
+
+  template <class> struct is_node_associative: std::false_type {};
+  template <class K, class V, class C, class A> struct is_node_associative<std::map<K, V, C, A>>: std::true_type {};
+  template <class K, class V, class C, class A> struct is_node_associative<std::multimap<K, V, C, A>>: std::true_type {};
+  template <class K, class C, class A> struct is_node_associative<std::set<K, C, A>>: std::true_type {};
+  template <class K, class C, class A> struct is_node_associative<std::multiset<K, C, A>>: std::true_type {};
+
+  template <class Container, class = void>
+  struct is_string: std::false_type {};
+
+  template <class Container>
+  struct is_string<Container, std::void_t<typename Container::traits_type>>: std::true_type {};
+
+  /// first guess of the node size of a node-based container (links and color of major implementations)
+  template <class Container>
+  inline constexpr std::size_t guessed_node_bytes = sizeof(typename Container::value_type) + 4 * sizeof(void*);
+
+  /// node size and alignment of `Container` observed from its allocator, zero until observed
+  /// (a torn pair only costs a retry)
+  template <class Container>
+  inline std::atomic<std::size_t> observed_node_bytes{0};
+  template <class Container>
+  inline std::atomic<std::size_t> observed_node_align{0};
+
+  /// Runs `op`, which makes at most one allocation with `fallible_allocator`, with a block acquired up front.
+  /// If the block does not fit, `bytes` and `align` are updated to the observed allocation and `op` runs again.
+  /// Panics if it does not fit again: `op` is not a supported container operation.
+  template <class Op>
+  auto reserved(std::size_t& bytes, std::size_t& align, Op& op) -> mut_result<std::invoke_result_t<Op&>, alloc_error> {
+    for (int attempt = 0; attempt < 2; ++attempt) {
+      reservation block(bytes, align);
+      if (!block) return failure(alloc_error{alloc_error_kind::allocation_failure, bytes});
+      try {
+        return success(op());
+      }
+      catch (stash_mismatch const&) {
+        bytes = pending.required_bytes;
+        align = pending.required_align;
+      }
+    }
+    // the memory was there: the operation allocates differently each time, which is not a supported container
+    PANIC("fallible container operation: the allocation of %1% bytes did not match the block acquired for it"
+          " (the container is not supported)", bytes);
+  }
+
+  /// Runs `op`, which allocates at most one node of `Container`, with a node acquired up front.
+  template <class Container, class Op>
+  auto with_node(Op&& op) -> mut_result<std::invoke_result_t<Op&&>, alloc_error> {
+    if constexpr (is_fallible_v<Container>) {
+      auto const observed = observed_node_bytes<Container>.load(std::memory_order_relaxed);
+      std::size_t bytes = observed != 0 ? observed : guessed_node_bytes<Container>;
+      std::size_t align = observed != 0
+        ? observed_node_align<Container>.load(std::memory_order_relaxed) : alignof(std::max_align_t);
+      auto res = reserved(bytes, align, op);
+      if (res.is_ok() && bytes != observed) {
+        observed_node_align<Container>.store(align, std::memory_order_relaxed);
+        observed_node_bytes<Container>.store(bytes, std::memory_order_relaxed);
+      }
+      return res;
+    }
+    else {
+      try { return success(std::forward<Op>(op)()); }
+      catch (std::bad_alloc const&) {
+        return failure(alloc_error{alloc_error_kind::allocation_failure, guessed_node_bytes<Container>});
+      }
+    }
+  }
+
+  /// capacity after growing `container` by one element
+  template <class Container>
+  std::size_t grown_capacity(Container const& container) {
+    auto const max = container.max_size();
+    auto const cap = container.capacity();
+    return std::max(container.size() + 1, cap > max / 2 ? max : cap * 2);
+  }
+}
+
+namespace mitama {
+
+/// @brief
+///   Reserves capacity for at least `new_cap` elements.
+///
+/// @return
+///   A reference to the container, or the reason of the failure.
+///   The container is left untouched on failure.
+template <class Container,
+  std::enable_if_t<_fallible_detail::has_capacity<Container>::value, bool> = false>
+auto try_reserve(Container& container, std::size_t new_cap)
+  -> mut_result<Container&, alloc_error>
+{
+  using value_type = typename Container::value_type;
+  if (new_cap <= container.capacity())
+    return success(container);
+  if (new_cap > container.max_size())
+    return failure(alloc_error{alloc_error_kind::capacity_overflow, 0});
+
+  if constexpr (_fallible_detail::is_fallible_v<Container>) {
+    // std::basic_string needs room for the terminator, and may grow geometrically on reserve
+    auto const elements = _fallible_detail::is_string<Container>::value
+      ? std::max(new_cap, std::min(container.capacity() * 2, container.max_size())) + 1
+      : new_cap;
+    std::size_t bytes = elements * sizeof(value_type);
+    std::size_t align = alignof(value_type);
+    auto op = [&]() -> Container& { container.reserve(new_cap); return container; };
+    return _fallible_detail::reserved(bytes, align, op);
+  }
+  else {
+    try {
+      container.reserve(new_cap);
+      return success(container);
+    }
+    catch (std::bad_alloc const&) {
+      return failure(alloc_error{alloc_error_kind::allocation_failure, new_cap * sizeof(value_type)});
+    }
+  }
+}
+
+/// @brief
+///   Resizes the container to `count` elements, appending value-initialized elements.
+///
+/// @return
+///   A reference to the container, or the reason of the failure.
+template <class Container,
+  std::enable_if_t<_fallible_detail::has_capacity<Container>::value, bool> = false>
+auto try_resize(Container& container, std::size_t count)
+  -> mut_result<Container&, alloc_error>
+{
+  if (auto reserved = try_reserve(container, count); reserved.is_err())
+    return reserved;
+  container.resize(count);
+  return success(container);
+}
+
+/// @brief
+///   Resizes the container to `count` elements, appending copies of `value`.
+///
+/// @return
+///   A reference to the container, or the reason of the failure.
+template <class Container,
+  std::enable_if_t<_fallible_detail::has_capacity<Container>::value, bool> = false>
+auto try_resize(Container& container, std::size_t count, typename Container::value_type const& value)
+  -> mut_result<Container&, alloc_error>
+{
+  if (auto reserved = try_reserve(container, count); reserved.is_err())
+    return reserved;
+  container.resize(count, value);
+  return success(container);
+}
+
+/// @brief
+///   Appends a new element constructed from `args...` to the end of the container.
+///
+/// @return
+///   A reference to the new element, or the reason of the failure.
+///   The container is left untouched on failure.
+template <class Container, class... Args>
+auto try_emplace_back(Container& container, Args&&... args)
+  -> mut_result<typename Container::value_type&, alloc_error>
+{
+  if constexpr (_fallible_detail::has_capacity<Container>::value) {
+    if (container.size() == container.capacity()) {
+      if (container.size() == container.max_size())
+        return failure(alloc_error{alloc_error_kind::capacity_overflow, 0});
+      if (auto reserved = try_reserve(container, _fallible_detail::grown_capacity(container)); reserved.is_err())
+        return failure(std::move(reserved).unwrap_err());
+    }
+    if constexpr (_fallible_detail::is_string<Container>::value) {
+      container.push_back(typename Container::value_type(std::forward<Args>(args)...));
+      return success(container.back());
+    }
+    else {
+      return success(container.emplace_back(std::forward<Args>(args)...));
+    }
+  }
+  else {
+    static_assert(_fallible_detail::is_node_sequence<Container>::value,
+                  "try_emplace_back: the container must have `capacity()` or be a std::list");
+    return _fallible_detail::with_node<Container>(
+      [&]() -> typename Container::value_type& { return container.emplace_back(std::forward<Args>(args)...); });
+  }
+}
+
+/// @brief
+///   Appends `value` to the end of the container.
+///
+/// @return
+///   A reference to the new element, or the reason of the failure.
+template <class Container, class U = typename Container::value_type>
+auto try_push_back(Container& container, U&& value)
+  -> mut_result<typename Container::value_type&, alloc_error>
+{
+  return try_emplace_back(container, std::forward<U>(value));
+}
+
+/// @brief
+///   Inserts `value` before `pos` of a sequence container.
+///
+/// @return
+///   A reference to the inserted element, or the reason of the failure.
+template <class Container, class U = typename Container::value_type,
+  std::enable_if_t<
+    _fallible_detail::has_capacity<Container>::value || _fallible_detail::is_node_sequence<Container>::value,
+  bool> = false>
+auto try_insert(Container& container, typename Container::const_iterator pos, U&& value)
+  -> mut_result<typename Container::value_type&, alloc_error>
+{
+  if constexpr (_fallible_detail::has_capacity<Container>::value) {
+    // reserving invalidates `pos`
+    auto const index = std::distance(container.cbegin(), pos);
+    if (container.size() == container.capacity()) {
+      if (container.size() == container.max_size())
+        return failure(alloc_error{alloc_error_kind::capacity_overflow, 0});
+      if (auto reserved = try_reserve(container, _fallible_detail::grown_capacity(container)); reserved.is_err())
+        return failure(std::move(reserved).unwrap_err());
+    }
+    return success(*container.insert(container.cbegin() + index, std::forward<U>(value)));
+  }
+  else {
+    return _fallible_detail::with_node<Container>(
+      [&]() -> typename Container::value_type& { return *container.insert(pos, std::forward<U>(value)); });
+  }
+}
+
+/// @brief
+///   Inserts `value` into an associative container (`std::map`, `std::set`, ...).
+///
+/// @return
+///   A reference to the element with the key of `value` (inserted or not), or the reason of the failure.
+template <class Container, class U = typename Container::value_type,
+  std::enable_if_t<_fallible_detail::is_node_associative<Container>::value, bool> = false>
+auto try_insert(Container& container, U&& value)
+  -> mut_result<std::remove_reference_t<decltype(*container.begin())>&, alloc_error>
+{
+  using reference = std::remove_reference_t<decltype(*container.begin())>&;
+  return _fallible_detail::with_node<Container>([&]() -> reference {
+    if constexpr (std::is_same_v<decltype(container.insert(std::forward<U>(value))), typename Container::iterator>)
+      return *container.insert(std::forward<U>(value));
+    else
+      return *container.insert(std::forward<U>(value)).first;
+  });
+}
+
+}
+
+#endif
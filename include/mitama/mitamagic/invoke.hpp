@@ -0,0 +1,34 @@
+#ifndef MITAMA_MITAMAGIC_INVOKE_HPP
+#define MITAMA_MITAMAGIC_INVOKE_HPP
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/// `constexpr` on functions that need C++20 library support to be evaluated at compile time
+/// (e.g. `std::variant::emplace`); expands to nothing before that.
+#if defined(__cpp_lib_variant) && __cpp_lib_variant >= 202106L
+#  define MITAMA_CXX20_CONSTEXPR constexpr
+#else
+#  define MITAMA_CXX20_CONSTEXPR
+#endif
+
+namespace mitama::mitamagic {
+
+/// @brief
+///   `std::invoke` usable in constant expressions before C++20.
+///
+/// @note
+///   Only pointers to members are delegated to `std::invoke`,
+///   so they are usable in constant expressions from C++20.
+template <class F, class... Args>
+constexpr std::invoke_result_t<F&&, Args&&...>
+invoke(F&& f, Args&&... args) noexcept(std::is_nothrow_invocable_v<F&&, Args&&...>) {
+  if constexpr (std::is_member_pointer_v<std::decay_t<F>>)
+    return std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+  else
+    return std::forward<F>(f)(std::forward<Args>(args)...);
+}
+
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef MITAMA_MITAMAGIC_IS_CONSTANT_EVALUATED_HPP
+#define MITAMA_MITAMAGIC_IS_CONSTANT_EVALUATED_HPP
+#include <type_traits>
+
+/// `MITAMA_IS_CONSTANT_EVALUATED()`: `std::is_constant_evaluated()`, or the compiler builtin before C++20.
+#if defined(__cpp_lib_is_constant_evaluated)
+#  define MITAMA_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__clang__) && defined(__has_builtin)
+#  if __has_builtin(__builtin_is_constant_evaluated)
+#    define MITAMA_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#  endif
+#elif defined(__GNUC__) && __GNUC__ >= 9
+#  define MITAMA_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#if !defined(MITAMA_IS_CONSTANT_EVALUATED)
+   // no way to tell: callers must behave correctly at run time with `false`.
+#  define MITAMA_IS_CONSTANT_EVALUATED() false
+#endif
+
+#endif
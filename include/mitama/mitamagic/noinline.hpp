@@ -0,0 +1,14 @@
+#ifndef MITAMA_MITAMAGIC_NOINLINE_HPP
+#define MITAMA_MITAMAGIC_NOINLINE_HPP
+
+/// Keeps a cold path (e.g. a one-time initialization) out of the inlined fast path of its caller.
+/// Expands to nothing on unsupported compilers.
+#if defined(__GNUC__) || defined(__clang__)
+#  define MITAMA_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#  define MITAMA_NOINLINE __declspec(noinline)
+#else
+#  define MITAMA_NOINLINE
+#endif
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef MITAMA_PANIC_HPP
 #define MITAMA_PANIC_HPP
 
+#include <mitama/mitamagic/is_constant_evaluated.hpp>
+
 #include <stdexcept>
 #include <boost/format.hpp>
 #include <variant>
@@ -60,14 +62,22 @@ public:
             (boost::format("', %1%:%2%\n\nstacktrace:\n%3%") % std::string{func} % line % std::forward<StackTrace>(st)).str()) {}
 #endif
 };
+
+/// @brief
+///   Deliberately not constexpr:
+///   a panic during constant evaluation calls this function, which makes the compiler reject the
+///   evaluation with a diagnostic naming it, pointing at the `PANIC(...)` that was reached.
+inline void panicked_during_constant_evaluation() noexcept {}
 }
 
 #if !defined(MITAMA_PANIC_WITH_STACKTRACE) 
 #define PANIC(...) \
-  throw ::mitama::runtime_panic { ::mitama::macro_use, __FILE__, __LINE__, __VA_ARGS__ }
+  ( MITAMA_IS_CONSTANT_EVALUATED() ? ::mitama::panicked_during_constant_evaluation() : void(), \
+    throw ::mitama::runtime_panic { ::mitama::macro_use, __FILE__, __LINE__, __VA_ARGS__ } )
 #else
 #define PANIC(...) \
-  throw ::mitama::runtime_panic { ::mitama::stacktarce_use, __FILE__, __LINE__, boost::stacktrace::stacktrace(), __VA_ARGS__ }
+  ( MITAMA_IS_CONSTANT_EVALUATED() ? ::mitama::panicked_during_constant_evaluation() : void(), \
+    throw ::mitama::runtime_panic { ::mitama::stacktarce_use, __FILE__, __LINE__, boost::stacktrace::stacktrace(), __VA_ARGS__ } )
 #endif
 
 #endif
@@ -0,0 +1,266 @@
+#ifndef MITAMA_PARSE_HPP
+#define MITAMA_PARSE_HPP
+#include <mitama/result/result.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+/// Decimal integers of up to `digits10` digits are converted eight digits at a time (SWAR) on little-endian targets.
+#if !defined(MITAMA_PARSE_SWAR)
+#  if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#    define MITAMA_PARSE_SWAR 1
+#  else
+#    define MITAMA_PARSE_SWAR 0
+#  endif
+#endif
+
+namespace mitama {
+
+/// @brief
+///   Why `parse` failed.
+enum class parse_error_kind : std::uint8_t {
+  /// the input is empty
+  empty,
+  /// the character at the offset is not part of a number (the offset is the size of the input if it ended early)
+  invalid_character,
+  /// the number is not representable by the type
+  out_of_range,
+};
+
+/// @brief
+///   Error of `parse`: what went wrong, and where.
+///
+/// @note
+///   Trivially copyable and 8 bytes, so that `result<T, parse_error>` stays small.
+struct parse_error {
+  /// offset into the input (saturated at 2^32-1)
+  std::uint32_t offset;
+  parse_error_kind kind;
+
+  friend constexpr bool operator==(parse_error const& lhs, parse_error const& rhs) noexcept {
+    return lhs.offset == rhs.offset && lhs.kind == rhs.kind;
+  }
+  friend constexpr bool operator!=(parse_error const& lhs, parse_error const& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, parse_error const& err) {
+    switch (err.kind) {
+      case parse_error_kind::empty: return os << "cannot parse a number from empty input";
+      case parse_error_kind::invalid_character: return os << "invalid character at offset " << err.offset;
+      case parse_error_kind::out_of_range: return os << "number out of range";
+    }
+    return os;
+  }
+};
+
+static_assert(std::is_trivially_copyable_v<parse_error>);
+
+}
+
+namespace mitama::_parse_detail {
+  template <class T>
+  inline constexpr bool is_integer_v = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+  template <class T, class = void>
+  struct is_parsable: std::bool_constant<is_integer_v<T>> {};
+
+  template <class T>
+  struct is_parsable<T, std::enable_if_t<std::is_enum_v<T>>>: std::bool_constant<is_integer_v<std::underlying_type_t<T>>> {};
+
+#if defined(__cpp_lib_to_chars)
+  template <class T>
+  struct is_parsable<T, std::enable_if_t<std::is_floating_point_v<T>>>: std::true_type {};
+#endif
+
+  constexpr std::uint32_t offset_of(std::size_t offset) noexcept {
+    return offset > std::numeric_limits<std::uint32_t>::max()
+      ? std::numeric_limits<std::uint32_t>::max()
+      : static_cast<std::uint32_t>(offset);
+  }
+
+#if MITAMA_PARSE_SWAR
+  inline std::uint64_t load8(char const* p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+  }
+
+  /// true if the 8 bytes of `v` are all '0'..'9'
+  constexpr bool is_eight_digits(std::uint64_t v) noexcept {
+    return ((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+  }
+
+  /// value of 8 decimal digits (the first in the lowest byte)
+  constexpr std::uint32_t eight_digits(std::uint64_t v) noexcept {
+    constexpr std::uint64_t mask = 0x000000FF000000FF;
+    constexpr std::uint64_t mul1 = 100 + (1000000ULL << 32);
+    constexpr std::uint64_t mul2 = 1 + (10000ULL << 32);
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8);
+    return static_cast<std::uint32_t>((((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32);
+  }
+#endif
+
+  /// Converts `n` (at most 19) decimal digits; false if there is a non-digit.
+  inline bool digits(char const* first, std::size_t n, std::uint64_t& out) noexcept {
+    std::uint64_t acc = 0;
+    std::size_t i = 0;
+#if MITAMA_PARSE_SWAR
+    for (; n - i >= 8; i += 8) {
+      auto const v = load8(first + i);
+      if (!is_eight_digits(v)) return false;
+      acc = acc * 100000000 + eight_digits(v);
+    }
+#endif
+    for (; i < n; ++i) {
+      auto const d = static_cast<unsigned>(static_cast<unsigned char>(first[i])) - '0';
+      if (d > 9) return false;
+      acc = acc * 10 + d;
+    }
+    out = acc;
+    return true;
+  }
+
+  template <class T, class... Format>
+  result<T, parse_error> from_chars(std::string_view str, std::size_t sign, Format... fmt) {
+    T value;
+    auto const first = str.data();
+    auto const last = first + str.size();
+    auto const [ptr, ec] = std::from_chars(first, last, value, fmt...);
+    if (ec == std::errc::result_out_of_range)
+      return failure(parse_error{0, parse_error_kind::out_of_range});
+    if (ec != std::errc{})
+      return failure(parse_error{offset_of(sign), parse_error_kind::invalid_character});
+    if (ptr != last)
+      return failure(parse_error{offset_of(static_cast<std::size_t>(ptr - first)), parse_error_kind::invalid_character});
+    return success(value);
+  }
+
+  template <class T>
+  result<T, parse_error> parse_integer(std::string_view str) {
+    std::size_t sign = 0;
+    if constexpr (std::is_signed_v<T>) {
+      if (str.front() == '-') sign = 1;
+    }
+    // no overflow is possible with up to digits10 digits
+    if (auto const n = str.size() - sign; n != 0 && n <= static_cast<std::size_t>(std::numeric_limits<T>::digits10)) {
+      std::uint64_t v;
+      if (digits(str.data() + sign, n, v)) {
+        if constexpr (std::is_signed_v<T>)
+          return success(static_cast<T>(sign ? -static_cast<std::int64_t>(v) : static_cast<std::int64_t>(v)));
+        else
+          return success(static_cast<T>(v));
+      }
+    }
+    return from_chars<T>(str, sign);
+  }
+}
+
+namespace mitama {
+
+/// @brief
+///   Parses the whole of `str` as a number of type `T`.
+///
+/// @return
+///   The number, or where and why `str` is not one.
+///
+/// @note
+///   `T` is an integer type (decimal, with an optional '-' for signed types), an enumeration
+///   (parsed as its underlying integer), or a floating point type if the standard library supports it.
+///   The syntax is that of `std::from_chars`: no leading whitespace nor '+'.
+template <class T,
+  std::enable_if_t<_parse_detail::is_parsable<T>::value, bool> = false>
+auto parse(std::string_view str) -> result<T, parse_error> {
+  if (str.empty())
+    return failure(parse_error{0, parse_error_kind::empty});
+  if constexpr (std::is_enum_v<T>) {
+    return parse<std::underlying_type_t<T>>(str).map([](auto v) { return static_cast<T>(v); });
+  }
+  else if constexpr (std::is_floating_point_v<T>) {
+    return _parse_detail::from_chars<T>(str, str.front() == '-');
+  }
+  else {
+    return _parse_detail::parse_integer<T>(str);
+  }
+}
+
+/// @brief
+///   Columnar output of `parse_all`.
+///   `values` holds a value for every row; the rows that failed hold `T{}`,
+///   and are listed in ascending order in `failed_rows`, with their errors in `errors`.
+template <class T>
+struct parse_column {
+  std::vector<T> values;
+  std::vector<std::size_t> failed_rows;
+  std::vector<parse_error> errors;
+
+  std::size_t size() const noexcept { return values.size(); }
+  /// true if every row was parsed
+  bool all_ok() const noexcept { return failed_rows.empty(); }
+
+  /// @brief
+  ///   The result of row `row`.
+  auto operator[](std::size_t row) const -> result<T, parse_error> {
+    if (auto it = std::lower_bound(failed_rows.begin(), failed_rows.end(), row); it != failed_rows.end() && *it == row)
+      return failure(errors[static_cast<std::size_t>(it - failed_rows.begin())]);
+    return success(values[row]);
+  }
+
+  void clear() noexcept {
+    values.clear();
+    failed_rows.clear();
+    errors.clear();
+  }
+};
+
+/// @brief
+///   Parses every string of `inputs`, appending the rows to `out`.
+///
+/// @note
+///   Reuse `out` (after `clear()`) to parse batches without reallocating the columns.
+template <class T, class Range,
+  std::enable_if_t<_parse_detail::is_parsable<T>::value, bool> = false>
+void parse_all(Range const& inputs, parse_column<T>& out) {
+  using std::begin, std::end;
+  auto first = begin(inputs);
+  auto last = end(inputs);
+  if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<decltype(first)>::iterator_category>)
+    out.values.reserve(out.values.size() + static_cast<std::size_t>(std::distance(first, last)));
+
+  for (; first != last; ++first) {
+    auto res = parse<T>(std::string_view(*first));
+    if (res.is_ok()) {
+      out.values.push_back(res.unwrap());
+    }
+    else {
+      out.failed_rows.push_back(out.values.size());
+      out.errors.push_back(res.unwrap_err());
+      out.values.push_back(T{});
+    }
+  }
+}
+
+/// @brief
+///   Parses every string of `inputs` into a `parse_column`.
+template <class T, class Range,
+  std::enable_if_t<_parse_detail::is_parsable<T>::value, bool> = false>
+auto parse_all(Range const& inputs) -> parse_column<T> {
+  parse_column<T> out;
+  parse_all(inputs, out);
+  return out;
+}
+
+}
+
+#endif
@@ -0,0 +1,383 @@
+#ifndef MITAMA_PIPELINE_HPP
+#define MITAMA_PIPELINE_HPP
+#include <mitama/maybe/maybe.hpp>
+#include <mitama/result/result.hpp>
+#include <mitama/mitamagic/invoke.hpp>
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/// Pipeable combinators.
+///
+/// `r | mitama::map(f) | mitama::and_then(g) | mitama::map_err(h)` builds a pipeline
+/// that is evaluated in one pass, when it is converted to its result type or `eval()` is called.
+/// The discriminator of `r` (and of every result returned by `and_then`/`or_else` stages) is tested once;
+/// stages that do not apply to the current state are skipped at compile time,
+/// and values flow from stage to stage without intermediate `basic_result`/`maybe` objects.
+///
+/// A pipeline refers to an lvalue source, so it must not outlive it (like a view).
+namespace mitama::_pipeline_detail {
+  template <class F> struct map_stage { F f; };
+  template <class F> struct and_then_stage { F f; };
+  template <class F> struct map_err_stage { F f; };
+  template <class F> struct or_else_stage { F f; };
+
+  template <class, template <class> class>
+  struct is_stage_of: std::false_type {};
+
+  template <class F, template <class> class Stage>
+  struct is_stage_of<Stage<F>, Stage>: std::true_type {};
+
+  template <class T>
+  using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+  /// reference to the success value of a result, of the value category of `Source`
+  template <class Source, class R = remove_cvref_t<Source>>
+  using ok_arg_t = decltype(std::get<success_t<typename R::ok_type>>(std::declval<Source>().into_storage()).get());
+
+  /// reference to the failure value of a result, of the value category of `Source`
+  template <class Source, class R = remove_cvref_t<Source>>
+  using err_arg_t = decltype(std::get<failure_t<typename R::err_type>>(std::declval<Source>().into_storage()).get());
+
+  template <class> struct maybe_element;
+  template <class T> struct maybe_element<maybe<T>> { using type = T; };
+
+  /// reference to the value of a maybe, of the value category of `Source`
+  template <class Source, class T = typename maybe_element<remove_cvref_t<Source>>::type>
+  using just_arg_t = std::conditional_t<std::is_lvalue_reference_v<Source>, decltype(std::declval<Source>().unwrap()), T&&>;
+
+  template <class Source>
+  constexpr just_arg_t<Source&&> just_value(Source&& src) {
+    return static_cast<just_arg_t<Source&&>>(src.unwrap());
+  }
+
+  /// Output type of a result pipeline:
+  /// `T`, `E` are the success/failure types so far,
+  /// `TArg`, `EArg` the types the next stage is invoked with.
+  template <mutability Mu, class T, class E, class TArg, class EArg, class... Stages>
+  struct result_fold {
+    using type = basic_result<Mu, T, E>;
+    using ok_arg = TArg;
+    using err_arg = EArg;
+  };
+
+  template <mutability Mu, class T, class E, class TArg, class EArg, class F, class... Stages>
+  struct result_fold<Mu, T, E, TArg, EArg, map_stage<F>, Stages...> {
+    static_assert(std::is_invocable_v<F, TArg>, "mitama::map: function object is not invocable with the success value");
+    using U = void_to_monostate_t<std::invoke_result_t<F, TArg>>;
+    using next = result_fold<Mu, U, E, U&&, EArg, Stages...>;
+    using type = typename next::type;
+    using ok_arg = typename next::ok_arg;
+    using err_arg = typename next::err_arg;
+  };
+
+  template <mutability Mu, class T, class E, class TArg, class EArg, class F, class... Stages>
+  struct result_fold<Mu, T, E, TArg, EArg, and_then_stage<F>, Stages...> {
+    static_assert(std::is_invocable_v<F, TArg>, "mitama::and_then: function object is not invocable with the success value");
+    using R = std::invoke_result_t<F, TArg>;
+    static_assert(is_result_v<remove_cvref_t<R>>, "mitama::and_then: function object must return basic_result");
+    using next = result_fold<
+      remove_cvref_t<R>::is_mut ? mutability::mut : mutability::immut,
+      typename remove_cvref_t<R>::ok_type, typename remove_cvref_t<R>::err_type,
+      ok_arg_t<R&&>, err_arg_t<R&&>, Stages...>;
+    using type = typename next::type;
+    using ok_arg = typename next::ok_arg;
+    using err_arg = typename next::err_arg;
+  };
+
+  template <mutability Mu, class T, class E, class TArg, class EArg, class F, class... Stages>
+  struct result_fold<Mu, T, E, TArg, EArg, map_err_stage<F>, Stages...> {
+    static_assert(std::is_invocable_v<F, EArg>, "mitama::map_err: function object is not invocable with the failure value");
+    using U = void_to_monostate_t<std::invoke_result_t<F, EArg>>;
+    using next = result_fold<Mu, T, U, TArg, U&&, Stages...>;
+    using type = typename next::type;
+    using ok_arg = typename next::ok_arg;
+    using err_arg = typename next::err_arg;
+  };
+
+  template <mutability Mu, class T, class E, class TArg, class EArg, class F, class... Stages>
+  struct result_fold<Mu, T, E, TArg, EArg, or_else_stage<F>, Stages...> {
+    static_assert(std::is_invocable_v<F, EArg>, "mitama::or_else: function object is not invocable with the failure value");
+    using R = std::invoke_result_t<F, EArg>;
+    static_assert(is_result_v<remove_cvref_t<R>>, "mitama::or_else: function object must return basic_result");
+    using next = result_fold<
+      remove_cvref_t<R>::is_mut ? mutability::mut : mutability::immut,
+      typename remove_cvref_t<R>::ok_type, typename remove_cvref_t<R>::err_type,
+      ok_arg_t<R&&>, err_arg_t<R&&>, Stages...>;
+    using type = typename next::type;
+    using ok_arg = typename next::ok_arg;
+    using err_arg = typename next::err_arg;
+  };
+
+  /// Output type of a maybe pipeline.
+  template <class T, class TArg, class... Stages>
+  struct maybe_fold {
+    using type = maybe<T>;
+  };
+
+  template <class T, class TArg, class F, class... Stages>
+  struct maybe_fold<T, TArg, map_stage<F>, Stages...> {
+    static_assert(std::is_invocable_v<F, TArg>, "mitama::map: function object is not invocable with the value");
+    using U = std::invoke_result_t<F, TArg>;
+    using type = typename maybe_fold<U, U&&, Stages...>::type;
+  };
+
+  template <class T, class TArg, class F, class... Stages>
+  struct maybe_fold<T, TArg, and_then_stage<F>, Stages...> {
+    static_assert(std::is_invocable_v<F, TArg>, "mitama::and_then: function object is not invocable with the value");
+    using R = std::invoke_result_t<F, TArg>;
+    static_assert(is_maybe<remove_cvref_t<R>>::value, "mitama::and_then: function object must return maybe");
+    using type = typename maybe_fold<typename maybe_element<remove_cvref_t<R>>::type, just_arg_t<R&&>, Stages...>::type;
+  };
+
+  template <class T, class TArg, class F, class... Stages>
+  struct maybe_fold<T, TArg, map_err_stage<F>, Stages...> {
+    static_assert([]{ return false; }(), "mitama::map_err: maybe has no failure value to map");
+  };
+
+  template <class T, class TArg, class F, class... Stages>
+  struct maybe_fold<T, TArg, or_else_stage<F>, Stages...> {
+    static_assert(std::is_invocable_v<F>, "mitama::or_else: function object is not invocable without arguments");
+    static_assert(is_maybe_with<remove_cvref_t<std::invoke_result_t<F>>, T>::value, "mitama::or_else: function object must return maybe<T>");
+    using type = typename maybe_fold<T, TArg, Stages...>::type;
+  };
+
+  template <class Source, class... Stages>
+  struct output;
+
+  template <mutability Mu, class T, class E, class Source, class... Stages>
+  struct output<basic_result<Mu, T, E>, Source, Stages...>
+    : result_fold<Mu, T, E, ok_arg_t<Source>, err_arg_t<Source>, Stages...> {};
+
+  template <class T, class Source, class... Stages>
+  struct output<maybe<T>, Source, Stages...>
+    : maybe_fold<T, just_arg_t<Source>, Stages...> {};
+
+  /// Types the stage `I` of a result pipeline is invoked with (`ok_arg`, `err_arg`).
+  template <std::size_t I, class Source, class Stages, class = std::make_index_sequence<I>>
+  struct stage_args;
+
+  template <std::size_t I, class Source, class... Stages, std::size_t... Is>
+  struct stage_args<I, Source, std::tuple<Stages...>, std::index_sequence<Is...>>
+    : output<remove_cvref_t<Source>, Source, std::tuple_element_t<Is, std::tuple<Stages...>>...> {};
+}
+
+namespace mitama {
+
+/// @brief
+///   A sequence of pipeline stages, created by `mitama::map` and friends.
+///   Adaptors compose with `|` into a longer adaptor.
+template <class... Stages>
+class pipe {
+  std::tuple<Stages...> stages_;
+public:
+  constexpr explicit pipe(Stages... stages): stages_(std::move(stages)...) {}
+
+  /// @brief
+  ///   Returns the stages.
+  constexpr std::tuple<Stages...>&& into_stages() && { return std::move(stages_); }
+
+  template <class... Rhs>
+  friend constexpr pipe<Stages..., Rhs...> operator|(pipe lhs, pipe<Rhs...> rhs) {
+    return std::apply([](auto&&... stages){ return pipe<Stages..., Rhs...>{std::move(stages)...}; },
+                      std::tuple_cat(std::move(lhs.stages_), std::move(rhs).into_stages()));
+  }
+};
+
+/// @brief
+///   A result or maybe with pending stages.
+///   Evaluated in one pass by `eval()` or by the conversion to `output_type`.
+///
+/// @note
+///   `Source` is an lvalue reference type for lvalue sources (then the source is not modified),
+///   and an object type for rvalue sources (then the source is moved into the pipeline).
+template <class Source, class... Stages>
+class [[nodiscard]] pipeline {
+  using source_type = _pipeline_detail::remove_cvref_t<Source>;
+  static constexpr bool is_result_pipeline = is_result_v<source_type>;
+  static constexpr std::size_t size = sizeof...(Stages);
+
+  Source source_;
+  std::tuple<Stages...> stages_;
+
+  template <class, class...> friend class pipeline;
+
+  template <std::size_t I>
+  using stage_t = std::tuple_element_t<I, std::tuple<Stages...>>;
+
+  template <std::size_t I, template <class> class Stage>
+  static constexpr bool is = _pipeline_detail::is_stage_of<stage_t<I>, Stage>::value;
+
+  template <std::size_t I>
+  constexpr decltype(auto) fn() { return std::move(std::get<I>(stages_).f); }
+
+public:
+  using output_type = typename _pipeline_detail::output<source_type, Source, Stages...>::type;
+
+  template <class Src>
+  constexpr pipeline(Src&& src, std::tuple<Stages...>&& stages)
+    : source_(std::forward<Src>(src)), stages_(std::move(stages)) {}
+
+  template <class... Rhs>
+  friend constexpr pipeline<Source, Stages..., Rhs...> operator|(pipeline&& lhs, pipe<Rhs...> rhs) {
+    return {std::forward<Source>(lhs.source_), std::tuple_cat(std::move(lhs.stages_), std::move(rhs).into_stages())};
+  }
+
+  /// @brief
+  ///   Runs the pipeline.
+  constexpr output_type eval() && {
+    if constexpr (is_result_pipeline) {
+      auto&& storage = std::forward<Source>(source_).into_storage();
+      if (source_.is_ok())
+        return run_ok<0>(std::get<success_t<typename source_type::ok_type>>(std::forward<decltype(storage)>(storage)).get());
+      else
+        return run_err<0>(std::get<failure_t<typename source_type::err_type>>(std::forward<decltype(storage)>(storage)).get());
+    }
+    else {
+      if (source_.is_just())
+        return run_ok<0>(_pipeline_detail::just_value(std::forward<Source>(source_)));
+      else
+        return run_err<0>();
+    }
+  }
+
+  constexpr operator output_type() && { return std::move(*this).eval(); }
+
+private:
+  /// success path: `v` is the value the stage `I` is invoked with
+  template <std::size_t I, class V>
+  constexpr output_type run_ok(V&& v) {
+    if constexpr (I == size) {
+      if constexpr (is_result_pipeline)
+        return output_type{in_place_ok, std::forward<V>(v)};
+      else
+        return output_type{std::in_place, std::forward<V>(v)};
+    }
+    else if constexpr (is<I, _pipeline_detail::map_stage>) {
+      if constexpr (std::is_void_v<std::invoke_result_t<decltype(fn<I>()), V&&>>) {
+        mitamagic::invoke(fn<I>(), std::forward<V>(v));
+        return run_ok<I + 1>(std::monostate{});
+      }
+      else {
+        return run_ok<I + 1>(mitamagic::invoke(fn<I>(), std::forward<V>(v)));
+      }
+    }
+    else if constexpr (is<I, _pipeline_detail::and_then_stage>) {
+      return branch<I + 1>(mitamagic::invoke(fn<I>(), std::forward<V>(v)));
+    }
+    else if constexpr (is<I, _pipeline_detail::or_else_stage> && is_result_pipeline) {
+      // skipped; the success type may change at this stage
+      using EArg = typename _pipeline_detail::stage_args<I, Source, std::tuple<Stages...>>::err_arg;
+      using R = _pipeline_detail::remove_cvref_t<std::invoke_result_t<decltype(fn<I>()), EArg>>;
+      if constexpr (std::is_same_v<_pipeline_detail::remove_cvref_t<V>, _pipeline_detail::remove_cvref_t<typename R::ok_type>>)
+        return run_ok<I + 1>(std::forward<V>(v));
+      else
+        return run_ok<I + 1>(typename R::ok_type(std::forward<V>(v)));
+    }
+    else {
+      return run_ok<I + 1>(std::forward<V>(v));
+    }
+  }
+
+  /// failure path: `e` is the failure value (results only)
+  template <std::size_t I, class... Err>
+  constexpr output_type run_err(Err&&... e) {
+    if constexpr (I == size) {
+      if constexpr (is_result_pipeline)
+        return output_type{in_place_err, std::forward<Err>(e)...};
+      else
+        return nothing;
+    }
+    else if constexpr (is<I, _pipeline_detail::map_err_stage>) {
+      if constexpr (std::is_void_v<std::invoke_result_t<decltype(fn<I>()), Err&&...>>) {
+        mitamagic::invoke(fn<I>(), std::forward<Err>(e)...);
+        return run_err<I + 1>(std::monostate{});
+      }
+      else {
+        return run_err<I + 1>(mitamagic::invoke(fn<I>(), std::forward<Err>(e)...));
+      }
+    }
+    else if constexpr (is<I, _pipeline_detail::or_else_stage>) {
+      MITAMA_ERROR_RETURN_TRACE_CLOSE();
+      return branch<I + 1>(mitamagic::invoke(fn<I>(), std::forward<Err>(e)...));
+    }
+    else if constexpr (is<I, _pipeline_detail::and_then_stage> && is_result_pipeline) {
+      // skipped; the failure type may change at this stage
+      using TArg = typename _pipeline_detail::stage_args<I, Source, std::tuple<Stages...>>::ok_arg;
+      using R = _pipeline_detail::remove_cvref_t<std::invoke_result_t<decltype(fn<I>()), TArg>>;
+      if constexpr (std::is_same_v<_pipeline_detail::remove_cvref_t<Err>..., _pipeline_detail::remove_cvref_t<typename R::err_type>>)
+        return run_err<I + 1>(std::forward<Err>(e)...);
+      else
+        return run_err<I + 1>(typename R::err_type(std::forward<Err>(e)...));
+    }
+    else {
+      return run_err<I + 1>(std::forward<Err>(e)...);
+    }
+  }
+
+  /// continues with the result of an `and_then`/`or_else` stage
+  template <std::size_t I, class R>
+  constexpr output_type branch(R&& r) {
+    if constexpr (is_result_v<_pipeline_detail::remove_cvref_t<R>>) {
+      using ok_type = typename _pipeline_detail::remove_cvref_t<R>::ok_type;
+      using err_type = typename _pipeline_detail::remove_cvref_t<R>::err_type;
+      auto&& storage = std::forward<R>(r).into_storage();
+      if (r.is_ok())
+        return run_ok<I>(std::get<success_t<ok_type>>(std::forward<decltype(storage)>(storage)).get());
+      else
+        return run_err<I>(std::get<failure_t<err_type>>(std::forward<decltype(storage)>(storage)).get());
+    }
+    else {
+      if (r.is_just())
+        return run_ok<I>(_pipeline_detail::just_value(std::forward<R>(r)));
+      else
+        return run_err<I>();
+    }
+  }
+};
+
+template <class Source, class... Stages,
+  std::enable_if_t<
+    std::disjunction_v<
+      is_result<_pipeline_detail::remove_cvref_t<Source>>,
+      is_maybe<_pipeline_detail::remove_cvref_t<Source>>>,
+  bool> = false>
+constexpr pipeline<std::conditional_t<std::is_lvalue_reference_v<Source>, Source, std::remove_cv_t<Source>>, Stages...>
+operator|(Source&& src, pipe<Stages...> stages) {
+  return {std::forward<Source>(src), std::move(stages).into_stages()};
+}
+
+/// @brief
+///   Pipeable `map`: transforms the success value (or the value of a maybe).
+template <class F>
+constexpr pipe<_pipeline_detail::map_stage<std::decay_t<F>>> map(F&& f) {
+  return pipe<_pipeline_detail::map_stage<std::decay_t<F>>>{{std::forward<F>(f)}};
+}
+
+/// @brief
+///   Pipeable `and_then`: continues with the result (or maybe) returned by `f`.
+template <class F>
+constexpr pipe<_pipeline_detail::and_then_stage<std::decay_t<F>>> and_then(F&& f) {
+  return pipe<_pipeline_detail::and_then_stage<std::decay_t<F>>>{{std::forward<F>(f)}};
+}
+
+/// @brief
+///   Pipeable `map_err`: transforms the failure value (results only).
+template <class F>
+constexpr pipe<_pipeline_detail::map_err_stage<std::decay_t<F>>> map_err(F&& f) {
+  return pipe<_pipeline_detail::map_err_stage<std::decay_t<F>>>{{std::forward<F>(f)}};
+}
+
+/// @brief
+///   Pipeable `or_else`: recovers from a failure (or nothing) with the result (or maybe) returned by `f`.
+template <class F>
+constexpr pipe<_pipeline_detail::or_else_stage<std::decay_t<F>>> or_else(F&& f) {
+  return pipe<_pipeline_detail::or_else_stage<std::decay_t<F>>>{{std::forward<F>(f)}};
+}
+
+}
+
+#endif
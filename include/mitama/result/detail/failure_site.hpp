@@ -0,0 +1,63 @@
+#ifndef MITAMA_RESULT_DETAIL_FAILURE_SITE_HPP
+#define MITAMA_RESULT_DETAIL_FAILURE_SITE_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__has_include) && __cplusplus >= 202002L
+  #if __has_include(<source_location>)
+    #include <source_location>
+  #endif
+#endif
+
+#if defined(__cpp_lib_source_location)
+  #define MITAMA_FAILURE_SITE_USE_SOURCE_LOCATION
+#elif defined(__clang__) && __clang_major__ < 9
+  // clang-8 and older do not provide __builtin_FILE and friends.
+#elif defined(__GNUC__)
+  #define MITAMA_FAILURE_SITE_USE_BUILTIN
+#endif
+
+namespace mitama {
+
+/// @brief
+///   Source location of the call that produced a failure.
+///
+/// @note
+///   `failure_site::current()` used as a default argument captures the location of the caller.
+///   On compilers without `std::source_location` nor `__builtin_FILE`, every site is reported as unknown.
+struct failure_site {
+  char const* file = "unknown";
+  char const* function = "unknown";
+  std::uint_least32_t line = 0;
+
+#if defined(MITAMA_FAILURE_SITE_USE_SOURCE_LOCATION)
+  static constexpr failure_site
+  current(std::source_location loc = std::source_location::current()) noexcept {
+    return failure_site{loc.file_name(), loc.function_name(), loc.line()};
+  }
+#elif defined(MITAMA_FAILURE_SITE_USE_BUILTIN)
+  static constexpr failure_site
+  current(char const* file = __builtin_FILE(),
+          char const* function = __builtin_FUNCTION(),
+          std::uint_least32_t line = __builtin_LINE()) noexcept {
+    return failure_site{file, function, line};
+  }
+#else
+  static constexpr failure_site current() noexcept { return failure_site{}; }
+#endif
+
+  friend bool operator==(failure_site const& lhs, failure_site const& rhs) noexcept {
+    return lhs.line == rhs.line
+        && (lhs.file == rhs.file || std::strcmp(lhs.file, rhs.file) == 0)
+        && (lhs.function == rhs.function || std::strcmp(lhs.function, rhs.function) == 0);
+  }
+
+  friend bool operator!=(failure_site const& lhs, failure_site const& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+};
+
+}
+
+#endif
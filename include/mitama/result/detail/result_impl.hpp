@@ -6,7 +6,9 @@
 #include <mitama/result/traits/impl_traits.hpp>
 #include <mitama/result/traits/deref.hpp>
 #include <mitama/result/detail/dangling.hpp>
+#include <mitama/result/error_return_trace.hpp>
 #include <mitama/maybe/maybe.hpp>
+#include <mitama/mitamagic/invoke.hpp>
 #include <optional>
 #include <functional>
 
@@ -16,7 +18,8 @@ template <class, class = void>
 class unwrap_or_default_friend_injector
 {
 public:
-  void unwrap_or_default() const = delete;
+  void unwrap_or_default() const& = delete;
+  void unwrap_or_default() && = delete;
 };
 
 /// @impl
@@ -35,8 +38,9 @@ public:
   ///   Consumes the self argument then,
   ///   if success, returns the contained value,
   ///   otherwise; if Err, returns the default value for that type.
-  T unwrap_or_default() const
+  T unwrap_or_default() const&
   {
+    if (static_cast<basic_result<_mu, T, E> const *>(this)->is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
     if constexpr (std::is_aggregate_v<T>){
       return static_cast<basic_result<_mu, T, E> const *>(this)->is_ok()
         ? static_cast<basic_result<_mu, T, E> const *>(this)->unwrap()
@@ -48,13 +52,36 @@ public:
         : T();
     }
   }
+
+  /// @brief
+  ///   Returns the contained value or a default.
+  ///
+  /// @note
+  ///   Consumes the self argument then,
+  ///   if success, moves out the contained value,
+  ///   otherwise; if Err, returns the default value for that type.
+  T unwrap_or_default() &&
+  {
+    if (static_cast<basic_result<_mu, T, E> *>(this)->is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
+    if constexpr (std::is_aggregate_v<T>){
+      return static_cast<basic_result<_mu, T, E> *>(this)->is_ok()
+        ? std::get<success_t<T>>(std::move(*static_cast<basic_result<_mu, T, E> *>(this)).into_storage()).get()
+        : T{};
+    }
+    else {
+      return static_cast<basic_result<_mu, T, E> *>(this)->is_ok()
+        ? std::get<success_t<T>>(std::move(*static_cast<basic_result<_mu, T, E> *>(this)).into_storage()).get()
+        : T();
+    }
+  }
 };
 
 template <class>
 class transpose_friend_injector
 {
 public:
-  void transpose() const = delete;
+  void transpose() const& = delete;
+  void transpose() && = delete;
 };
 
 /// @impl
@@ -84,6 +111,27 @@ public:
         return maybe<basic_result<_mutability ,T, E>>{std::in_place, in_place_err, static_cast<basic_result<_mutability, maybe<T>, E>const*>(this)->unwrap_err()};
     }
   }
+
+  /// @brief
+  ///   Transposes a result of maybe into a maybe of result.
+  ///
+  /// @note
+  ///   Consumes the self argument, moving the contained value into the returned maybe.
+  maybe<basic_result<_mutability ,T, E>> transpose() &&
+  {
+    auto&& storage = std::move(*static_cast<basic_result<_mutability, maybe<T>, E>*>(this)).into_storage();
+    if (auto* ok = std::get_if<success_t<maybe<T>>>(&storage)) {
+      if (ok->get()) {
+        return maybe<basic_result<_mutability ,T, E>>{std::in_place, in_place_ok, std::move(ok->get()).unwrap()};
+      }
+      else {
+        return mitama::nothing;
+      }
+    }
+    else {
+        return maybe<basic_result<_mutability ,T, E>>{std::in_place, in_place_err, std::get<failure_t<E>>(std::move(storage)).get()};
+    }
+  }
 };
 
 template <class, class = void>
@@ -626,7 +674,7 @@ public:
 
     return static_cast<basic_result<_mu, T, E>*>(this)->is_ok()
       ? static_cast<result_type>(std::apply(std::forward<O>(op), std::tuple_cat(static_cast<basic_result<_mu, T, E>*>(this)->unwrap(), std::forward_as_tuple(std::forward<Args>(args))...)))
-      : static_cast<result_type>(failure(static_cast<basic_result<_mu, T, E>*>(this)->unwrap_err()));
+      : static_cast<result_type>(failure_t{static_cast<basic_result<_mu, T, E>*>(this)->unwrap_err()});
   }
 
   template <class O, class... Args,
@@ -649,7 +697,7 @@ public:
 
     return static_cast<basic_result<_mu, T, E> const *>(this)->is_ok()
       ? static_cast<result_type>(std::apply(std::forward<O>(op), std::tuple_cat(static_cast<basic_result<_mu, T, E> const *>(this)->unwrap(), std::forward_as_tuple(std::forward<Args>(args))...)))
-      : static_cast<result_type>(failure(static_cast<basic_result<_mu, T, E> const *>(this)->unwrap_err()));
+      : static_cast<result_type>(failure_t{static_cast<basic_result<_mu, T, E> const *>(this)->unwrap_err()});
   }
 
   template <class O, class... Args,
@@ -672,7 +720,7 @@ public:
 
     return static_cast<basic_result<_mu, T, E>*>(this)->is_ok()
       ? static_cast<result_type>(std::apply(std::forward<O>(op), std::tuple_cat(std::move(static_cast<basic_result<_mu, T, E>*>(this)->unwrap()), std::forward_as_tuple(std::forward<Args>(args)...))))
-      : static_cast<result_type>(failure(std::move(static_cast<basic_result<_mu, T, E>*>(this)->unwrap_err())));
+      : static_cast<result_type>(failure_t{std::move(static_cast<basic_result<_mu, T, E>*>(this)->unwrap_err())});
   }
 };
 
@@ -707,6 +755,7 @@ public:
             std::declval<const E&>(),
             std::forward_as_tuple(std::forward<Args>(args))...)));
 
+    if (static_cast<basic_result<_mu, T, E> const *>(this)->is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
     return static_cast<basic_result<_mu, T, E> const *>(this)->is_err()
       ? static_cast<result_type>(std::apply(std::forward<O>(op), std::tuple_cat(static_cast<basic_result<_mu, T, E> const *>(this)->unwrap_err(), std::forward_as_tuple(std::forward<Args>(args))...)))
       : static_cast<result_type>(success(static_cast<basic_result<_mu, T, E> const *>(this)->unwrap()));
@@ -0,0 +1,149 @@
+#ifndef MITAMA_RESULT_ERROR_RETURN_TRACE_HPP
+#define MITAMA_RESULT_ERROR_RETURN_TRACE_HPP
+
+#include <mitama/result/detail/failure_site.hpp>
+#include <mitama/mitamagic/is_constant_evaluated.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+/// Error return traces.
+///
+/// Define `MITAMA_ERROR_RETURN_TRACE` (before including any mitama header) to make
+/// `mitama::failure(...)` start a new trace on the current thread and every `MITAMA_TRY`
+/// that propagates a failure append its location to the trace.
+/// The trace lives in a fixed-size thread-local ring buffer, so a hop costs a few stores;
+/// when more than `MITAMA_ERROR_RETURN_TRACE_DEPTH` hops are recorded, the oldest are overwritten.
+/// Without the macro, nothing is recorded and `current()` is always empty.
+///
+/// A trace is closed when its failure is recovered by `or_else`, `unwrap_or`, `unwrap_or_else`,
+/// `unwrap_or_default` or `map_or_else` (it stays readable by `current()`, e.g. from the handler).
+/// A `MITAMA_TRY` that propagates a failure while no trace is in progress starts a new trace
+/// without an origin: this is the case for failures not made by a recorded `failure(...)`,
+/// such as `in_place_err` results or `maybe::ok_or`.
+/// A failure inspected by hand (`is_err()`, `unwrap_err()`) is not recovered for the trace;
+/// call `clear()` after handling it.
+#ifndef MITAMA_ERROR_RETURN_TRACE_DEPTH
+#define MITAMA_ERROR_RETURN_TRACE_DEPTH 32
+#endif
+
+namespace mitama::error_return_trace {
+
+/// @brief
+///   Propagation path of the most recent failure on a thread.
+struct trace_t {
+  /// where `failure(...)` was called, if known
+  bool has_origin = false;
+  failure_site origin{};
+  /// `MITAMA_TRY` sites the failure passed through, from the innermost to the outermost
+  std::vector<failure_site> frames;
+  /// number of hops overwritten in the ring buffer (older than frames.front())
+  std::size_t dropped = 0;
+
+  friend std::ostream& operator<<(std::ostream& os, trace_t const& trace) {
+    os << "error return trace:\n";
+    if (trace.has_origin)
+      os << "  failure at " << trace.origin.file << ':' << trace.origin.line << " (" << trace.origin.function << ")\n";
+    if (trace.dropped != 0)
+      os << "  ... " << trace.dropped << " frames dropped ...\n";
+    for (auto const& frame: trace.frames)
+      os << "  propagated at " << frame.file << ':' << frame.line << " (" << frame.function << ")\n";
+    return os;
+  }
+};
+
+}
+
+#if defined(MITAMA_ERROR_RETURN_TRACE)
+namespace mitama::error_return_trace::_detail {
+
+  inline constexpr std::size_t depth = MITAMA_ERROR_RETURN_TRACE_DEPTH;
+  static_assert(depth != 0, "MITAMA_ERROR_RETURN_TRACE_DEPTH must not be zero");
+
+  struct ring {
+    failure_site frames[depth];
+    std::size_t pushed;
+    failure_site origin;
+    bool has_origin;
+    bool in_progress;
+  };
+
+  // constant-initialized, so access needs no guard
+  static_assert(std::is_trivially_destructible_v<ring> && (static_cast<void>(ring{}), true));
+  inline thread_local ring buffer{};
+
+  /// starts a new trace with a known origin
+  inline void begin(failure_site const& site) noexcept {
+    buffer.origin = site;
+    buffer.has_origin = true;
+    buffer.pushed = 0;
+    buffer.in_progress = true;
+  }
+
+  /// starts a new trace whose origin is unknown
+  inline void begin() noexcept {
+    buffer.has_origin = false;
+    buffer.pushed = 0;
+    buffer.in_progress = true;
+  }
+
+  inline void push(failure_site const& site) noexcept {
+    if (!buffer.in_progress)
+      begin();
+    buffer.frames[buffer.pushed % depth] = site;
+    ++buffer.pushed;
+  }
+
+  /// the failure of the trace has been recovered
+  inline void close() noexcept {
+    buffer.in_progress = false;
+  }
+}
+
+#  define MITAMA_ERROR_RETURN_TRACE_PUSH() \
+    ::mitama::error_return_trace::_detail::push(::mitama::failure_site{__FILE__, __func__, __LINE__})
+#  define MITAMA_ERROR_RETURN_TRACE_BEGIN() \
+    (MITAMA_IS_CONSTANT_EVALUATED() ? static_cast<void>(0) : ::mitama::error_return_trace::_detail::begin())
+#  define MITAMA_ERROR_RETURN_TRACE_CLOSE() \
+    (MITAMA_IS_CONSTANT_EVALUATED() ? static_cast<void>(0) : ::mitama::error_return_trace::_detail::close())
+#else
+#  define MITAMA_ERROR_RETURN_TRACE_PUSH() static_cast<void>(0)
+#  define MITAMA_ERROR_RETURN_TRACE_BEGIN() static_cast<void>(0)
+#  define MITAMA_ERROR_RETURN_TRACE_CLOSE() static_cast<void>(0)
+#endif
+
+namespace mitama::error_return_trace {
+
+/// @brief
+///   Returns the trace of the most recent failure on this thread.
+inline trace_t current() {
+  trace_t trace;
+#if defined(MITAMA_ERROR_RETURN_TRACE)
+  auto const& buf = _detail::buffer;
+  trace.has_origin = buf.has_origin;
+  trace.origin = buf.origin;
+  auto const kept = buf.pushed < _detail::depth ? buf.pushed : _detail::depth;
+  trace.dropped = buf.pushed - kept;
+  trace.frames.reserve(kept);
+  for (std::size_t i = buf.pushed - kept; i != buf.pushed; ++i)
+    trace.frames.push_back(buf.frames[i % _detail::depth]);
+#endif
+  return trace;
+}
+
+/// @brief
+///   Forgets the trace of the current thread.
+inline void clear() noexcept {
+#if defined(MITAMA_ERROR_RETURN_TRACE)
+  _detail::buffer.pushed = 0;
+  _detail::buffer.has_origin = false;
+  _detail::buffer.in_progress = false;
+#endif
+}
+
+}
+
+#endif
@@ -3,11 +3,17 @@
 #include <mitama/mitamagic/is_interface_of.hpp>
 #include <mitama/result/detail/fwd.hpp>
 #include <mitama/result/detail/meta.hpp>
+#include <mitama/mitamagic/is_constant_evaluated.hpp>
 #include <mitama/result/traits/impl_traits.hpp>
+#if defined(MITAMA_FAILURE_STATISTICS)
+#include <mitama/result/failure_statistics.hpp>
+#endif
+#include <mitama/result/error_return_trace.hpp>
 #include <boost/hana/functional/fix.hpp>
 #include <boost/hana/functional/overload.hpp>
 #include <boost/hana/functional/overload_linearly.hpp>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -70,14 +76,14 @@ public:
                   std::is_constructible<E, U&&>,
                   std::is_convertible<U&&, E>> = required>
   constexpr failure_t(failure_t<U> && t) noexcept(std::is_nothrow_constructible_v<E, U>)
-      : x(std::move(t.get())) {}
+      : x(static_cast<U&&>(t.get())) {}
 
   template <typename U,
             where<std::negation<std::is_same<E, U>>,
                   std::is_constructible<E, U&&>,
                   std::negation<std::is_convertible<U&&, E>>> = required>
   explicit constexpr failure_t(failure_t<U> && t) noexcept(std::is_nothrow_constructible_v<E, U>)
-      : x(std::move(t.get())) {}
+      : x(static_cast<U&&>(t.get())) {}
 
   template <class... Args,
             where<std::is_constructible<E, Args...>> = required>
@@ -238,9 +244,9 @@ public:
     return rhs <= *this;
   }
 
-  E& get() & { return x; }
-  E const& get() const& { return x; }
-  E&& get() && { return std::move(x); }
+  constexpr E& get() & { return x; }
+  constexpr E const& get() const& { return x; }
+  constexpr E&& get() && { return std::move(x); }
 
 };
 
@@ -250,7 +256,7 @@ class [[nodiscard]] failure_t<E&>
 {
   template <class, class...>
   friend class failure_t;
-  std::reference_wrapper<E> x;
+  E* x;
 
   template <class... Requires>
   using where = std::enable_if_t<std::conjunction_v<Requires...>, std::nullptr_t>;
@@ -263,13 +269,13 @@ public:
   using err_type = E&;
 
   failure_t() = delete;
-  explicit constexpr failure_t(E& err) : x(err) {}
-  explicit constexpr failure_t(std::in_place_t, E& err) : x(err) {}
+  explicit constexpr failure_t(E& err) : x(std::addressof(err)) {}
+  explicit constexpr failure_t(std::in_place_t, E& err) : x(std::addressof(err)) {}
 
   template <class Derived, std::enable_if_t<mitamagic::is_interface_of_v<std::decay_t<E>, std::decay_t<Derived>>, bool> = false>
-  explicit constexpr failure_t(Derived& derived) : x(derived) {}
+  explicit constexpr failure_t(Derived& derived) : x(std::addressof(derived)) {}
   template <class Derived, std::enable_if_t<mitamagic::is_interface_of_v<std::decay_t<E>, std::decay_t<Derived>>, bool> = false>
-  explicit constexpr failure_t(std::in_place_t, Derived& derived) : x(derived) {}
+  explicit constexpr failure_t(std::in_place_t, Derived& derived) : x(std::addressof(derived)) {}
 
   explicit constexpr failure_t(failure_t &&) = default;
   explicit constexpr failure_t(failure_t const&) = default;
@@ -281,7 +287,7 @@ public:
       is_comparable_with<E, E_>::value,
       bool>
   constexpr operator==(basic_result<_mut, T_, E_> const& rhs) const {
-    return rhs.is_err() ? rhs.unwrap_err() == this->x : false;
+    return rhs.is_err() ? rhs.unwrap_err() == this->get() : false;
   }
 
   template <class T_>
@@ -296,7 +302,7 @@ public:
     is_comparable_with<E, E_>::value,
   bool>
   operator==(failure_t<E_> const& rhs) const {
-    return this->x == rhs.x;
+    return this->get() == rhs.get();
   }
 
   template <mutability _mut, class T_, class E_>
@@ -320,7 +326,7 @@ public:
     is_comparable_with<E, E_>::value,
   bool>
   operator!=(failure_t<E_> const& rhs) const {
-    return !(this->x == rhs.x);
+    return !(this->get() == rhs.get());
   }
 
   template <mutability _mut, class T_, class E_>
@@ -329,7 +335,7 @@ public:
     is_comparable_with<E, E_>::value,
   bool>
   operator<(basic_result<_mut, T_, E_> const& rhs) const {
-    return rhs.is_err() ? this->x < rhs.unwrap_err() : true;
+    return rhs.is_err() ? this->get() < rhs.unwrap_err() : true;
   }
 
   template <class T_>
@@ -344,7 +350,7 @@ public:
     meta::is_less_comparable_with<E, E_>::value,
   bool>
   operator<(failure_t<E_> const& rhs) const {
-    return this->x < rhs.x;
+    return this->get() < rhs.get();
   }
 
   template <mutability _mut, class T_, class E_>
@@ -356,7 +362,7 @@ public:
   bool>
   operator<=(basic_result<_mut, T_, E_> const& rhs) const
   {
-    return rhs.is_err() ? (this->x == rhs.unwrap_err()) || (this->x < rhs.unwrap_err()) : true;
+    return rhs.is_err() ? (this->get() == rhs.unwrap_err()) || (this->get() < rhs.unwrap_err()) : true;
   }
 
   template <class T_>
@@ -383,7 +389,7 @@ public:
   bool>
   operator>(basic_result<_mut, T_, E_> const& rhs) const
   {
-    return rhs.is_err() ? rhs.unwrap_err() < this->x : false;
+    return rhs.is_err() ? rhs.unwrap_err() < this->get() : false;
   }
 
   template <class T_>
@@ -410,7 +416,7 @@ public:
   bool>
   operator>=(basic_result<_mut, T_, E_> const& rhs) const
   {
-    return rhs.is_err() ? (rhs.unwrap_err() == this->x) || (rhs.unwrap_err() < this->x) : false;
+    return rhs.is_err() ? (rhs.unwrap_err() == this->get()) || (rhs.unwrap_err() < this->get()) : false;
   }
 
   template <class T_>
@@ -430,9 +436,9 @@ public:
     return rhs <= *this;
   }
 
-  E& get() & { return x.get(); }
-  E const& get() const& { return x.get(); }
-  E& get() && { return x.get(); }
+  constexpr E& get() & { return *x; }
+  constexpr E const& get() const& { return *x; }
+  constexpr E& get() && { return *x; }
 
 };
 
@@ -443,15 +449,16 @@ public:
   public:
     constexpr explicit failure_t(Args... args): args(std::forward<Args>(args)...) {}
 
-    auto operator()() && {
+    constexpr auto operator()() && {
       return std::apply([](auto&&... fwd){
         return std::forward_as_tuple(std::forward<decltype(fwd)>(fwd)...);
       }, args);
     }
   };
 
-  template <class Target = void, class... Types>
-  inline auto failure(Types&&... v) {
+namespace _result_detail {
+  template <class Target, class... Types>
+  constexpr auto make_failure(Types&&... v) {
     if constexpr (!std::is_void_v<Target>) {
       if constexpr (sizeof...(Types) < 2)
         return failure_t<Target>{std::forward<Types>(v)...};
@@ -467,6 +474,53 @@ public:
         return failure_t<_result_detail::forward_mode<>, Types&&...>{std::forward<Types>(v)...};
     }
   }
+}
+
+#if !defined(MITAMA_FAILURE_STATISTICS) && !defined(MITAMA_ERROR_RETURN_TRACE)
+  template <class Target = void, class... Types>
+  constexpr auto failure(Types&&... v) {
+    return _result_detail::make_failure<Target>(std::forward<Types>(v)...);
+  }
+#else
+namespace _result_detail {
+  inline void on_failure([[maybe_unused]] failure_site const& site) noexcept {
+#  if defined(MITAMA_FAILURE_STATISTICS)
+    failure_statistics::_detail::record(site);
+#  endif
+#  if defined(MITAMA_ERROR_RETURN_TRACE)
+    error_return_trace::_detail::begin(site);
+#  endif
+  }
+}
+
+  /// @note
+  ///   Records the call site into `failure_statistics` and/or starts a new `error_return_trace`.
+  template <class Target = void>
+  constexpr auto failure(failure_site site = failure_site::current()) {
+    if (!MITAMA_IS_CONSTANT_EVALUATED())
+      _result_detail::on_failure(site);
+    return _result_detail::make_failure<Target>();
+  }
+
+  /// @note
+  ///   Records the call site into `failure_statistics` and/or starts a new `error_return_trace`.
+  template <class Target = void, class Type>
+  constexpr auto failure(Type&& v, failure_site site = failure_site::current()) {
+    if (!MITAMA_IS_CONSTANT_EVALUATED())
+      _result_detail::on_failure(site);
+    return _result_detail::make_failure<Target>(std::forward<Type>(v));
+  }
+
+  /// @note
+  ///   The in-place (n-ary) form has no call site:
+  ///   a defaulted call site parameter cannot follow a parameter pack.
+  ///   It is not counted by `failure_statistics`, and starts an `error_return_trace` without an origin.
+  template <class Target = void, class T1, class T2, class... Types>
+  constexpr auto failure(T1&& v1, T2&& v2, Types&&... v) {
+    MITAMA_ERROR_RETURN_TRACE_BEGIN();
+    return _result_detail::make_failure<Target>(std::forward<T1>(v1), std::forward<T2>(v2), std::forward<Types>(v)...);
+  }
+#endif
 
   /// @brief
   ///   ostream output operator
@@ -8,6 +8,7 @@
 #include <boost/hana/functional/overload.hpp>
 #include <boost/hana/functional/overload_linearly.hpp>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -70,14 +71,14 @@ public:
                   std::is_constructible<T, U&&>,
                   std::is_convertible<U&&, T>> = required>
   constexpr success_t(success_t<U> && t) noexcept(std::is_nothrow_constructible_v<T, U>)
-      : x(std::move(t.get())) {}
+      : x(static_cast<U&&>(t.get())) {}
 
   template <typename U,
             where<std::negation<std::is_same<T, U>>,
                   std::is_constructible<T, U&&>,
                   std::negation<std::is_convertible<U&&, T>>> = required>
   explicit constexpr success_t(success_t<U> && t) noexcept(std::is_nothrow_constructible_v<T, U>)
-      : x(std::move(t.get())) {}
+      : x(static_cast<U&&>(t.get())) {}
 
   template <class... Args,
             where<std::is_constructible<T, Args...>> = required>
@@ -234,9 +235,9 @@ public:
     return true;
   }
 
-  T& get() & { return x; }
-  T const& get() const& { return x; }
-  T&& get() && { return std::move(x); }
+  constexpr T& get() & { return x; }
+  constexpr T const& get() const& { return x; }
+  constexpr T&& get() && { return std::move(x); }
 
 };
 
@@ -245,7 +246,7 @@ class [[nodiscard]] success_t<T&>
 {
   template <class, class...>
   friend class success_t;
-  std::reference_wrapper<T> x;
+  T* x;
 
   template <class... Requires>
   using where = std::enable_if_t<std::conjunction_v<Requires...>, std::nullptr_t>;
@@ -258,13 +259,13 @@ public:
   using ok_type = T&;
 
   success_t() = delete;
-  explicit constexpr success_t(T& ok) : x(ok) {}
-  explicit constexpr success_t(std::in_place_t, T& ok) : x(ok) {}
+  explicit constexpr success_t(T& ok) : x(std::addressof(ok)) {}
+  explicit constexpr success_t(std::in_place_t, T& ok) : x(std::addressof(ok)) {}
 
   template <class Derived, std::enable_if_t<mitamagic::is_interface_of_v<std::decay_t<T>, std::decay_t<Derived>>, bool> = false>
-  explicit constexpr success_t(Derived& derived) : x(derived) {}
+  explicit constexpr success_t(Derived& derived) : x(std::addressof(derived)) {}
   template <class Derived, std::enable_if_t<mitamagic::is_interface_of_v<std::decay_t<T>, std::decay_t<Derived>>, bool> = false>
-  explicit constexpr success_t(std::in_place_t, Derived& derived) : x(derived) {}
+  explicit constexpr success_t(std::in_place_t, Derived& derived) : x(std::addressof(derived)) {}
 
   explicit constexpr success_t(success_t &&) = default;
   explicit constexpr success_t(success_t const&) = default;
@@ -277,7 +278,7 @@ public:
     meta::is_comparable_with<T, T_>::value,
   bool>
   operator==(basic_result<_mut, T_, E_> const& rhs) const {
-    return rhs.is_ok() ? rhs.unwrap() == this->x : false;
+    return rhs.is_ok() ? rhs.unwrap() == this->get() : false;
   }
 
   template <class T_>
@@ -286,7 +287,7 @@ public:
     meta::is_comparable_with<T, T_>::value,
   bool>
   operator==(success_t<T_> const& rhs) const {
-    return this->x == rhs.x;
+    return this->get() == rhs.get();
   }
 
   template <class E_>
@@ -301,7 +302,7 @@ public:
     meta::is_comparable_with<T, T_>::value,
   bool>
   operator!=(basic_result<_mut, T_, E_> const& rhs) const {
-    return rhs.is_ok() ? !(rhs.unwrap() == this->x) : true;
+    return rhs.is_ok() ? !(rhs.unwrap() == this->get()) : true;
   }
 
   template <class T_>
@@ -310,7 +311,7 @@ public:
     meta::is_comparable_with<T, T_>::value,
   bool>
   operator!=(success_t<T_> const& rhs) const {
-    return !(this->x == rhs.x);
+    return !(this->get() == rhs.get());
   }
 
   template <class E_>
@@ -325,7 +326,7 @@ public:
     meta::is_less_comparable_with<T, T_>::value,
   bool>
   operator<(basic_result<_mut, T_, E_> const& rhs) const {
-    return rhs.is_ok() ? this->x < rhs.unwrap() : false;
+    return rhs.is_ok() ? this->get() < rhs.unwrap() : false;
   }
 
   template <class T_>
@@ -334,7 +335,7 @@ public:
     meta::is_less_comparable_with<T, T_>::value,
   bool>
   operator<(success_t<T_> const& rhs) const {
-    return this->x < rhs.x;
+    return this->get() < rhs.get();
   }
 
   template <class E_>
@@ -351,7 +352,7 @@ public:
   bool>
   operator<=(basic_result<_mut, T_, E_> const& rhs) const
   {
-    return rhs.is_ok() ? (this->x == rhs.unwrap()) || (this->x < rhs.unwrap()) : false;
+    return rhs.is_ok() ? (this->get() == rhs.unwrap()) || (this->get() < rhs.unwrap()) : false;
   }
 
   template <class T_>
@@ -361,7 +362,7 @@ public:
     meta::is_less_comparable_with<T, T_>::value,
   bool>
   operator<=(success_t<T_> const& rhs) const {
-    return (this->x == rhs.x) || (this->x < rhs.x);
+    return (this->get() == rhs.get()) || (this->get() < rhs.get());
   }
 
   template <class E_>
@@ -377,7 +378,7 @@ public:
   bool>
   operator>(basic_result<_mut, T_, E_> const& rhs) const
   {
-    return rhs.is_ok() ? rhs.unwrap() < this->x : true;
+    return rhs.is_ok() ? rhs.unwrap() < this->get() : true;
   }
 
   template <class T_>
@@ -403,7 +404,7 @@ public:
   bool>
   operator>=(basic_result<_mut, T_, E_> const& rhs) const
   {
-    return rhs.is_ok() ? (rhs.unwrap() == this->x) || (rhs.is_ok() < this->x) : true;
+    return rhs.is_ok() ? (rhs.unwrap() == this->get()) || (rhs.is_ok() < this->get()) : true;
   }
 
   template <class T_>
@@ -421,9 +422,9 @@ public:
     return true;
   }
 
-  T& get() & { return x.get(); }
-  T const& get() const& { return x.get(); }
-  T& get() && { return x.get(); }
+  constexpr T& get() & { return *x; }
+  constexpr T const& get() const& { return *x; }
+  constexpr T& get() && { return *x; }
 
 };
 
@@ -434,7 +435,7 @@ public:
   public:
     constexpr explicit success_t(Args... args): args(std::forward<Args>(args)...) {}
 
-    auto operator()() && {
+    constexpr auto operator()() && {
       return std::apply([](auto&&... fwd){
         return std::forward_as_tuple(std::forward<decltype(fwd)>(fwd)...);
       }, args);
@@ -442,7 +443,7 @@ public:
   };
 
   template <class Target = void, class... Types>
-  inline auto success(Types&&... v) {
+  constexpr auto success(Types&&... v) {
     if constexpr (!std::is_void_v<Target>) {
       if constexpr (sizeof...(Types) < 2)
         return success_t<Target>{std::forward<Types>(v)...};
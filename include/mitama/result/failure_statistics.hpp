@@ -0,0 +1,309 @@
+#ifndef MITAMA_RESULT_FAILURE_STATISTICS_HPP
+#define MITAMA_RESULT_FAILURE_STATISTICS_HPP
+
+#include <mitama/result/detail/failure_site.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// Per-call-site failure statistics.
+///
+/// Define `MITAMA_FAILURE_STATISTICS` (before including any mitama header) to make
+/// every call of `mitama::failure(...)` with zero or one argument record its call site.
+/// Without the macro, nothing is recorded and `snapshot()` is always empty.
+///
+/// Each thread counts into its own fixed-capacity table, so the hot path takes no lock
+/// and performs no read-modify-write atomic operation.
+/// Tables are aggregated on demand by `snapshot()`.
+#ifndef MITAMA_FAILURE_STATISTICS_CAPACITY
+#define MITAMA_FAILURE_STATISTICS_CAPACITY 256
+#endif
+
+namespace mitama::failure_statistics {
+
+/// @brief
+///   Number of failures produced at a call site.
+struct entry {
+  std::string file;
+  std::string function;
+  std::uint_least32_t line;
+  std::uint64_t count;
+};
+
+/// @brief
+///   Aggregated failure counts over all threads, sorted by descending count.
+///
+/// @note
+///   `dropped` counts failures that were not recorded because a thread table was full,
+///   or whose call site could not be kept for lack of memory when their thread exited.
+struct snapshot_t {
+  std::vector<entry> entries;
+  std::uint64_t dropped = 0;
+
+  std::uint64_t total() const noexcept {
+    std::uint64_t sum = dropped;
+    for (auto const& e: entries) sum += e.count;
+    return sum;
+  }
+};
+
+}
+
+#if defined(MITAMA_FAILURE_STATISTICS)
+namespace mitama::failure_statistics::_detail {
+
+  inline constexpr std::size_t capacity = MITAMA_FAILURE_STATISTICS_CAPACITY;
+  static_assert(capacity != 0 && (capacity & (capacity - 1)) == 0,
+                "MITAMA_FAILURE_STATISTICS_CAPACITY must be a power of two");
+
+  /// A counter written by its owner thread only.
+  /// Relaxed load + store (not fetch_add) compiles to plain moves,
+  /// while still letting `snapshot()` read it from another thread.
+  inline void bump(std::atomic<std::uint64_t>& counter) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  struct slot {
+    std::atomic<bool> used{false};
+    failure_site site{};
+    std::atomic<std::uint64_t> count{0};
+  };
+
+  /// Open-addressing table keyed by call site, owned by one thread.
+  class table {
+    std::array<slot, capacity> slots_{};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    // Only the line is hashed: the same file may be spelled by distinct
+    // string literals in distinct translation units.
+    static std::size_t hash(failure_site const& site) noexcept {
+      auto h = static_cast<std::uint64_t>(site.line) * 0x9E3779B97F4A7C15ull;
+      return static_cast<std::size_t>(h >> 32);
+    }
+
+  public:
+    void record(failure_site const& site) noexcept {
+      std::size_t i = hash(site) & (capacity - 1);
+      for (std::size_t probe = 0; probe < capacity; ++probe, i = (i + 1) & (capacity - 1)) {
+        slot& s = slots_[i];
+        if (!s.used.load(std::memory_order_relaxed)) {
+          s.site = site;
+          s.count.store(1, std::memory_order_relaxed);
+          // publishes `site` to readers
+          s.used.store(true, std::memory_order_release);
+          return;
+        }
+        if (s.site == site) {
+          bump(s.count);
+          return;
+        }
+      }
+      bump(dropped_);
+    }
+
+    template <class F>
+    void for_each(F&& f) const {
+      for (auto const& s: slots_) {
+        if (s.used.load(std::memory_order_acquire))
+          f(s.site, s.count.load(std::memory_order_relaxed));
+      }
+    }
+
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    void reset() noexcept {
+      for (auto& s: slots_) s.count.store(0, std::memory_order_relaxed);
+      dropped_.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  using key = std::tuple<std::string, std::string, std::uint_least32_t>;
+
+  class thread_table;
+
+  /// Tables of live threads, and merged counts of exited threads.
+  ///
+  /// @note
+  ///   Live tables are linked through the tables themselves,
+  ///   so that registering a thread does not allocate (`record` is `noexcept`).
+  struct registry {
+    std::mutex mutex;
+    thread_table* live = nullptr;
+    std::map<key, std::uint64_t> retired;
+    std::uint64_t retired_dropped = 0;
+
+    static registry& instance() {
+      static registry r;
+      return r;
+    }
+  };
+
+  inline void merge(std::map<key, std::uint64_t>& into, table const& t) {
+    t.for_each([&](failure_site const& site, std::uint64_t count) {
+      if (count != 0)
+        into[key{site.file, site.function, site.line}] += count;
+    });
+  }
+
+  class thread_table {
+    table table_;
+    thread_table* prev_ = nullptr;
+    thread_table* next_ = nullptr;
+  public:
+    thread_table() noexcept {
+      auto& r = registry::instance();
+      std::lock_guard lock{r.mutex};
+      next_ = r.live;
+      if (next_) next_->prev_ = this;
+      r.live = this;
+    }
+
+    ~thread_table() {
+      auto& r = registry::instance();
+      std::lock_guard lock{r.mutex};
+      table_.for_each([&](failure_site const& site, std::uint64_t count) {
+        if (count == 0) return;
+        try {
+          r.retired[key{site.file, site.function, site.line}] += count;
+        }
+        catch (...) {
+          // out of memory: kept as dropped failures
+          r.retired_dropped += count;
+        }
+      });
+      r.retired_dropped += table_.dropped();
+      (prev_ ? prev_->next_ : r.live) = next_;
+      if (next_) next_->prev_ = prev_;
+    }
+
+    thread_table(thread_table const&) = delete;
+    thread_table& operator=(thread_table const&) = delete;
+
+    table& get() noexcept { return table_; }
+    table const& get() const noexcept { return table_; }
+    thread_table* next() noexcept { return next_; }
+    thread_table const* next() const noexcept { return next_; }
+  };
+
+  inline table& local() noexcept {
+    thread_local thread_table t;
+    return t.get();
+  }
+
+  inline void record(failure_site const& site) noexcept {
+    local().record(site);
+  }
+}
+#endif
+
+namespace mitama::failure_statistics {
+
+/// @brief
+///   Aggregates the counters of all threads (including exited ones).
+///
+/// @note
+///   Failures recorded concurrently with the call may or may not be included.
+inline snapshot_t snapshot() {
+  snapshot_t snap;
+#if defined(MITAMA_FAILURE_STATISTICS)
+  auto& r = _detail::registry::instance();
+  std::map<_detail::key, std::uint64_t> merged;
+  {
+    std::lock_guard lock{r.mutex};
+    merged = r.retired;
+    snap.dropped = r.retired_dropped;
+    for (auto const* t = r.live; t; t = t->next()) {
+      _detail::merge(merged, t->get());
+      snap.dropped += t->get().dropped();
+    }
+  }
+  snap.entries.reserve(merged.size());
+  for (auto& [k, count]: merged)
+    snap.entries.push_back(entry{std::get<0>(k), std::get<1>(k), std::get<2>(k), count});
+  std::stable_sort(snap.entries.begin(), snap.entries.end(),
+                   [](entry const& a, entry const& b) { return a.count > b.count; });
+#endif
+  return snap;
+}
+
+/// @brief
+///   Sets every counter to zero.
+///
+/// @note
+///   A failure recorded concurrently on another thread may survive the reset.
+inline void reset() {
+#if defined(MITAMA_FAILURE_STATISTICS)
+  auto& r = _detail::registry::instance();
+  std::lock_guard lock{r.mutex};
+  r.retired.clear();
+  r.retired_dropped = 0;
+  for (auto* t = r.live; t; t = t->next()) t->get().reset();
+#endif
+}
+
+/// @brief
+///   Writes one `count file:line function` line per call site.
+inline std::ostream& write_text(std::ostream& os, snapshot_t const& snap) {
+  for (auto const& e: snap.entries)
+    os << e.count << ' ' << e.file << ':' << e.line << ' ' << e.function << '\n';
+  if (snap.dropped != 0)
+    os << snap.dropped << " (dropped: statistics table full)\n";
+  return os;
+}
+
+namespace _detail {
+  inline void write_json_string(std::ostream& os, std::string_view str) {
+    os << '"';
+    for (char c: str) {
+      switch (c) {
+        case '"':  os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\t': os << "\\t"; break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[7];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+            os << buf;
+          }
+          else {
+            os << c;
+          }
+      }
+    }
+    os << '"';
+  }
+}
+
+/// @brief
+///   Writes the snapshot as a JSON object:
+///   `{"dropped": N, "sites": [{"file": ..., "line": ..., "function": ..., "count": ...}, ...]}`.
+inline std::ostream& write_json(std::ostream& os, snapshot_t const& snap) {
+  os << "{\"dropped\":" << snap.dropped << ",\"sites\":[";
+  bool first = true;
+  for (auto const& e: snap.entries) {
+    if (!std::exchange(first, false)) os << ',';
+    os << "{\"file\":";
+    _detail::write_json_string(os, e.file);
+    os << ",\"line\":" << e.line << ",\"function\":";
+    _detail::write_json_string(os, e.function);
+    os << ",\"count\":" << e.count << '}';
+  }
+  return os << "]}";
+}
+
+}
+
+#endif
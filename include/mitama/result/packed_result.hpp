@@ -0,0 +1,347 @@
+#ifndef MITAMA_RESULT_PACKED_RESULT_HPP
+#define MITAMA_RESULT_PACKED_RESULT_HPP
+#include <mitama/result/result.hpp>
+#include <mitama/maybe/maybe.hpp>
+#include <mitama/panic.hpp>
+#include <mitama/mitamagic/invoke.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace mitama {
+  /// @brief
+  ///   Number of bits `packed_result` stores for a `T`.
+  ///
+  /// @note
+  ///   The whole object representation by default; `bool` takes one bit.
+  ///   Specialize it for an enumeration whose values need fewer bits than its underlying type
+  ///   (the values must then be non-negative and fit in that many bits).
+  template <class T, class = void>
+  struct packed_bits: std::integral_constant<std::size_t, sizeof(T) * CHAR_BIT> {};
+
+  template <>
+  struct packed_bits<bool>: std::integral_constant<std::size_t, 1> {};
+
+  template <class T>
+  inline constexpr std::size_t packed_bits_v = packed_bits<T>::value;
+
+  template <class T, class E>
+  class packed_result;
+
+  template <class>
+  struct is_packed_result: std::false_type {};
+
+  template <class T, class E>
+  struct is_packed_result<packed_result<T, E>>: std::true_type {};
+}
+
+namespace mitama::_packed_detail {
+  /// the smallest unsigned integer of at least `Bits` bits
+  template <std::size_t Bits>
+  using storage_t =
+    std::conditional_t<(Bits <= 8), std::uint8_t,
+    std::conditional_t<(Bits <= 16), std::uint16_t,
+    std::conditional_t<(Bits <= 32), std::uint32_t,
+    std::uint64_t>>>;
+
+  template <class T>
+  inline constexpr bool is_packable_v =
+    std::is_trivially_copyable_v<T> && !std::is_reference_v<T> && sizeof(T) <= sizeof(std::uint64_t);
+
+  template <class T>
+  constexpr std::uint64_t to_bits(T const& v) noexcept {
+    if constexpr (std::is_same_v<T, bool>) {
+      return v ? 1 : 0;
+    }
+    else if constexpr (std::is_enum_v<T>) {
+      return static_cast<std::make_unsigned_t<std::underlying_type_t<T>>>(v);
+    }
+    else if constexpr (std::is_integral_v<T>) {
+      return static_cast<std::make_unsigned_t<T>>(v);
+    }
+    else {
+      std::uint64_t bits = 0;
+      std::memcpy(&bits, &v, sizeof(T));
+      return bits;
+    }
+  }
+
+  template <class T>
+  constexpr T from_bits(std::uint64_t bits) noexcept {
+    if constexpr (std::is_same_v<T, bool>) {
+      return bits != 0;
+    }
+    else if constexpr (std::is_enum_v<T>) {
+      return static_cast<T>(static_cast<std::make_unsigned_t<std::underlying_type_t<T>>>(bits));
+    }
+    else if constexpr (std::is_integral_v<T>) {
+      return static_cast<T>(static_cast<std::make_unsigned_t<T>>(bits));
+    }
+    else {
+      T v;
+      std::memcpy(&v, &bits, sizeof(T));
+      return v;
+    }
+  }
+
+  /// @brief
+  ///   Encoding of `packed_result<T, E>`:
+  ///   the payload in the low bits of the smallest integer that fits, and the discriminator in the bit above.
+  template <class T, class E>
+  struct layout {
+    static_assert(is_packable_v<T> && is_packable_v<E>,
+                  "packed_result: T and E must be trivially copyable and at most 8 bytes");
+    static constexpr std::size_t payload_bits = std::max(packed_bits_v<T>, packed_bits_v<E>);
+    static_assert(payload_bits < 64, "packed_result: T and E must leave a bit for the discriminator");
+
+    using storage_type = storage_t<payload_bits + 1>;
+    static constexpr storage_type err_tag = storage_type(storage_type(1) << payload_bits);
+    static constexpr storage_type payload_mask = storage_type(err_tag - 1);
+
+    static constexpr storage_type encode_ok(T const& v) noexcept {
+      return static_cast<storage_type>(to_bits<T>(v) & payload_mask);
+    }
+    static constexpr storage_type encode_err(E const& e) noexcept {
+      return static_cast<storage_type>((to_bits<E>(e) & payload_mask) | err_tag);
+    }
+    static constexpr bool is_ok(storage_type bits) noexcept { return (bits & err_tag) == 0; }
+    static constexpr T decode_ok(storage_type bits) noexcept { return from_bits<T>(bits & payload_mask); }
+    static constexpr E decode_err(storage_type bits) noexcept { return from_bits<E>(bits & payload_mask); }
+  };
+
+  /// @brief
+  ///   Encoding of `packed_result<T*, E>` in a `std::uintptr_t`:
+  ///   a success is the address itself, whose lowest bit is clear for any `T` aligned to 2 bytes or more;
+  ///   a failure is the error shifted left by one, with the lowest bit set.
+  template <class T, class E>
+  struct layout<T*, E> {
+    static_assert(is_packable_v<E>, "packed_result: E must be trivially copyable and at most 8 bytes");
+    static_assert(packed_bits_v<E> < sizeof(std::uintptr_t) * CHAR_BIT,
+                  "packed_result<T*, E>: E must leave a bit for the discriminator");
+
+    using storage_type = std::uintptr_t;
+    static constexpr storage_type err_tag = 1;
+
+    static storage_type encode_ok(T* p) noexcept {
+      static_assert(alignof(T) >= 2, "packed_result<T*, E>: T must be aligned to 2 bytes or more");
+      return reinterpret_cast<storage_type>(p);
+    }
+    static constexpr storage_type encode_err(E const& e) noexcept {
+      return static_cast<storage_type>(to_bits<E>(e) << 1) | err_tag;
+    }
+    static constexpr bool is_ok(storage_type bits) noexcept { return (bits & err_tag) == 0; }
+    static T* decode_ok(storage_type bits) noexcept { return reinterpret_cast<T*>(bits); }
+    static constexpr E decode_err(storage_type bits) noexcept { return from_bits<E>(bits >> 1); }
+  };
+}
+
+namespace mitama {
+  /// @brief
+  ///   A result of small trivially copyable values, packed into a single unsigned integer:
+  ///   the payload in the low bits and the discriminator in the bit above.
+  ///
+  ///   The integer is the smallest one that holds `max(packed_bits<T>, packed_bits<E>) + 1` bits,
+  ///   e.g. 8 bits for `packed_result<bool, E>` where `packed_bits<E>` is 7 (a `result` takes 2 bytes).
+  ///   `packed_result<T*, E>` is a single `std::uintptr_t`, tagging the failure in the lowest (alignment) bit.
+  ///   Testing and copying are integer operations.
+  ///
+  /// @note
+  ///   It has the combinators of `basic_result` that do not hand out references
+  ///   (the values are not stored as objects), and converts to and from `result<T, E>`.
+  template <class T, class E>
+  class packed_result {
+    using layout = _packed_detail::layout<T, E>;
+
+  public:
+    using ok_type = T;
+    using err_type = E;
+    using storage_type = typename layout::storage_type;
+
+  private:
+    storage_type bits_;
+
+    struct from_bits_t {};
+    constexpr packed_result(from_bits_t, storage_type bits) noexcept: bits_(bits) {}
+
+  public:
+    template <class U,
+      std::enable_if_t<std::is_convertible_v<U const&, T>, bool> = false>
+    constexpr packed_result(success_t<U> const& ok) noexcept
+      : bits_(layout::encode_ok(static_cast<T>(ok.get()))) {}
+
+    template <class U,
+      std::enable_if_t<std::is_convertible_v<U const&, E>, bool> = false>
+    constexpr packed_result(failure_t<U> const& err) noexcept
+      : bits_(layout::encode_err(static_cast<E>(err.get()))) {}
+
+    /// @brief
+    ///   Packs a `basic_result`.
+    template <mutability _mu>
+    constexpr explicit packed_result(basic_result<_mu, T, E> const& res)
+      : packed_result(res.is_ok()
+          ? packed_result(success_t<T>(res.unwrap()))
+          : packed_result(failure_t<E>(res.unwrap_err()))) {}
+
+    /// @brief
+    ///   The packed representation.
+    constexpr storage_type to_bits() const noexcept { return bits_; }
+
+    /// @brief
+    ///   Restores a `packed_result` from `to_bits()`.
+    static constexpr packed_result from_bits(storage_type bits) noexcept { return {from_bits_t{}, bits}; }
+
+    constexpr bool is_ok() const noexcept { return layout::is_ok(bits_); }
+    constexpr bool is_err() const noexcept { return !is_ok(); }
+    constexpr explicit operator bool() const noexcept { return is_ok(); }
+
+    /// @brief
+    ///   Returns the success value.
+    ///
+    /// @panics
+    ///   Panics if the value is a failure.
+    constexpr T unwrap() const {
+      if (is_err()) {
+        if constexpr (trait::formattable_element<E>::value)
+          PANIC("called `packed_result::unwrap()` on a value: `failure(%1%)`", unwrap_err_unchecked());
+        else
+          PANIC("called `packed_result::unwrap()` on a value `failure(?)`");
+      }
+      return unwrap_unchecked();
+    }
+
+    /// @brief
+    ///   Returns the failure value.
+    ///
+    /// @panics
+    ///   Panics if the value is a success.
+    constexpr E unwrap_err() const {
+      if (is_ok()) {
+        if constexpr (trait::formattable_element<T>::value)
+          PANIC("called `packed_result::unwrap_err()` on a value: `success(%1%)`", unwrap_unchecked());
+        else
+          PANIC("called `packed_result::unwrap_err()` on a value `success(?)`");
+      }
+      return unwrap_err_unchecked();
+    }
+
+    /// @brief
+    ///   Returns the success value, or `def` for a failure.
+    constexpr T unwrap_or(T def) const noexcept {
+      // a branchless select, so that loops over arrays of packed results vectorize
+      auto const ok_mask = static_cast<storage_type>(storage_type(0) - storage_type(is_ok()));
+      return layout::decode_ok((bits_ & ok_mask) | (layout::encode_ok(def) & storage_type(~ok_mask)));
+    }
+
+    /// @brief
+    ///   Returns the success value, or `f(err)` for a failure.
+    template <class F,
+      std::enable_if_t<std::is_invocable_r_v<T, F&&, E>, bool> = false>
+    constexpr T unwrap_or_else(F&& f) const {
+      return is_ok() ? unwrap_unchecked() : mitamagic::invoke(std::forward<F>(f), unwrap_err_unchecked());
+    }
+
+    constexpr maybe<T> ok() const {
+      if (is_ok()) return maybe<T>(std::in_place, unwrap_unchecked());
+      return nothing;
+    }
+
+    constexpr maybe<E> err() const {
+      if (is_err()) return maybe<E>(std::in_place, unwrap_err_unchecked());
+      return nothing;
+    }
+
+    /// @brief
+    ///   Maps the success value with `f`: `packed_result<T, E> -> packed_result<U, E>`.
+    template <class F>
+    constexpr auto map(F&& f) const
+      -> packed_result<std::decay_t<std::invoke_result_t<F&&, T>>, E>
+    {
+      if (is_ok()) return success_t(mitamagic::invoke(std::forward<F>(f), unwrap_unchecked()));
+      return failure_t<E>(unwrap_err_unchecked());
+    }
+
+    /// @brief
+    ///   Maps the failure value with `f`: `packed_result<T, E> -> packed_result<T, F>`.
+    template <class F>
+    constexpr auto map_err(F&& f) const
+      -> packed_result<T, std::decay_t<std::invoke_result_t<F&&, E>>>
+    {
+      if (is_err()) return failure_t(mitamagic::invoke(std::forward<F>(f), unwrap_err_unchecked()));
+      return success_t<T>(unwrap_unchecked());
+    }
+
+    /// @brief
+    ///   Calls `f` with the success value; `f` returns a `packed_result<U, E>`.
+    template <class F,
+      std::enable_if_t<is_packed_result<std::decay_t<std::invoke_result_t<F&&, T>>>::value, bool> = false>
+    constexpr auto and_then(F&& f) const
+      -> std::decay_t<std::invoke_result_t<F&&, T>>
+    {
+      if (is_ok()) return mitamagic::invoke(std::forward<F>(f), unwrap_unchecked());
+      return failure_t<E>(unwrap_err_unchecked());
+    }
+
+    /// @brief
+    ///   Calls `f` with the failure value; `f` returns a `packed_result<T, F>`.
+    template <class F,
+      std::enable_if_t<is_packed_result<std::decay_t<std::invoke_result_t<F&&, E>>>::value, bool> = false>
+    constexpr auto or_else(F&& f) const
+      -> std::decay_t<std::invoke_result_t<F&&, E>>
+    {
+      if (is_err()) return mitamagic::invoke(std::forward<F>(f), unwrap_err_unchecked());
+      return success_t<T>(unwrap_unchecked());
+    }
+
+    /// @brief
+    ///   Unpacks into a `result<T, E>`.
+    constexpr auto to_result() const -> result<T, E> {
+      if (is_ok()) return success_t<T>(unwrap_unchecked());
+      return failure_t<E>(unwrap_err_unchecked());
+    }
+
+    friend constexpr bool operator==(packed_result const& lhs, packed_result const& rhs) noexcept {
+      return lhs.bits_ == rhs.bits_;
+    }
+    friend constexpr bool operator!=(packed_result const& lhs, packed_result const& rhs) noexcept {
+      return lhs.bits_ != rhs.bits_;
+    }
+
+    template <class U>
+    friend constexpr bool operator==(packed_result const& lhs, success_t<U> const& rhs) {
+      return lhs.is_ok() && lhs.unwrap_unchecked() == rhs.get();
+    }
+    template <class U>
+    friend constexpr bool operator==(packed_result const& lhs, failure_t<U> const& rhs) {
+      return lhs.is_err() && lhs.unwrap_err_unchecked() == rhs.get();
+    }
+    template <class U>
+    friend constexpr bool operator!=(packed_result const& lhs, success_t<U> const& rhs) { return !(lhs == rhs); }
+    template <class U>
+    friend constexpr bool operator!=(packed_result const& lhs, failure_t<U> const& rhs) { return !(lhs == rhs); }
+
+    template <class T_ = T, class E_ = E,
+      std::enable_if_t<trait::formattable_element<T_>::value && trait::formattable_element<E_>::value, bool> = false>
+    friend std::ostream& operator<<(std::ostream& os, packed_result const& res) {
+      if (res.is_ok()) return os << "success(" << res.unwrap_unchecked() << ")";
+      return os << "failure(" << res.unwrap_err_unchecked() << ")";
+    }
+
+  private:
+    constexpr T unwrap_unchecked() const noexcept { return layout::decode_ok(bits_); }
+    constexpr E unwrap_err_unchecked() const noexcept { return layout::decode_err(bits_); }
+  };
+
+  template <class T, class E>
+  packed_result(basic_result<mutability::immut, T, E> const&) -> packed_result<T, E>;
+
+  template <class T, class E>
+  packed_result(basic_result<mutability::mut, T, E> const&) -> packed_result<T, E>;
+}
+
+#endif
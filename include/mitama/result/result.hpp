@@ -3,8 +3,10 @@
 #include <mitama/result/detail/fwd.hpp>
 #include <mitama/result/detail/meta.hpp>
 #include <mitama/panic.hpp>
+#include <mitama/mitamagic/invoke.hpp>
 #include <mitama/result/factory/success.hpp>
 #include <mitama/result/factory/failure.hpp>
+#include <mitama/result/error_return_trace.hpp>
 #include <mitama/anyhow/error.hpp>
 
 #include <boost/hana/functional/overload.hpp>
@@ -426,19 +428,19 @@ public:
 
   /// @brief
   ///   Returns result storage.
-  decltype(auto) into_storage() & {
-    return storage_;
+  constexpr decltype(auto) into_storage() & {
+    return (storage_);
   }
 
   /// @brief
   ///   Returns result storage.
-  decltype(auto) into_storage() const& {
-    return storage_;
+  constexpr decltype(auto) into_storage() const& {
+    return (storage_);
   }
 
   /// @brief
   ///   Returns result storage.
-  decltype(auto) into_storage() && {
+  constexpr decltype(auto) into_storage() && {
     return std::move(storage_);
   }
 
@@ -460,6 +462,22 @@ public:
     }
   }
 
+  /// @brief
+  ///   Converts from basic_result to `maybe<T>`.
+  ///
+  /// @note
+  ///   Consumes self, moving the success value (if any) into the resulting `maybe<T>`.
+  constexpr
+  maybe<std::remove_reference_t<ok_type>>
+  ok() && {
+    if (is_ok()) {
+      return maybe<std::remove_reference_t<ok_type>>(std::in_place, std::get<success_t<T>>(std::move(storage_)).get());
+    }
+    else {
+      return nothing;
+    }
+  }
+
   /// @brief
   ///   Converts from basic_result to `maybe`.
   ///
@@ -476,6 +494,22 @@ public:
     }
   }
 
+  /// @brief
+  ///   Converts from basic_result to `maybe<E>`.
+  ///
+  /// @note
+  ///   Consumes self, moving the failure value (if any) into the resulting `maybe<E>`.
+  constexpr
+  maybe<std::remove_reference_t<err_type>>
+  err() && {
+    if (is_err()) {
+      return maybe<std::remove_reference_t<err_type>>(std::in_place, std::get<failure_t<E>>(std::move(storage_)).get());
+    }
+    else {
+      return nothing;
+    }
+  }
+
   /// @brief
   ///   Produces a new basic_result, containing a reference into the original, leaving the original in place.
   constexpr auto as_ref() const&
@@ -530,11 +564,11 @@ public:
     using result_type = basic_result<_mutability, void_to_monostate_t<std::invoke_result_t<O, T, Args&&...>>, E>;
     if constexpr (std::is_void_v<std::invoke_result_t<O, T, Args&&...>>)
       return is_ok()
-                 ? std::invoke(std::forward<O>(op), std::get<success_t<T>>(storage_).get(), std::forward<Args>(args)...), static_cast<result_type>(success_t{})
+                 ? mitamagic::invoke(std::forward<O>(op), std::get<success_t<T>>(storage_).get(), std::forward<Args>(args)...), static_cast<result_type>(success_t{})
                  : static_cast<result_type>(failure_t{std::get<failure_t<E>>(storage_).get()});
     else
       return is_ok()
-                 ? static_cast<result_type>(success_t{std::invoke(std::forward<O>(op), std::get<success_t<T>>(storage_).get(), std::forward<Args>(args)...)})
+                 ? static_cast<result_type>(success_t{mitamagic::invoke(std::forward<O>(op), std::get<success_t<T>>(storage_).get(), std::forward<Args>(args)...)})
                  : static_cast<result_type>(failure_t{std::get<failure_t<E>>(storage_).get()});
   }
 
@@ -561,11 +595,11 @@ public:
     using result_type = basic_result<_mutability, void_to_monostate_t<std::invoke_result_t<O, Args&&...>>, E>;
     if constexpr (std::is_void_v<std::invoke_result_t<O, Args&&...>>)
       return is_ok()
-                 ? std::invoke(std::forward<O>(op), std::forward<Args>(args)...), static_cast<result_type>(success_t{})
+                 ? mitamagic::invoke(std::forward<O>(op), std::forward<Args>(args)...), static_cast<result_type>(success_t{})
                  : static_cast<result_type>(failure_t{std::get<failure_t<E>>(storage_).get()});
     else
       return is_ok()
-                 ? static_cast<result_type>(success_t{std::invoke(std::forward<O>(op), std::forward<Args>(args)...)})
+                 ? static_cast<result_type>(success_t{mitamagic::invoke(std::forward<O>(op), std::forward<Args>(args)...)})
                  : static_cast<result_type>(failure_t{std::get<failure_t<E>>(storage_).get()});
   }
 
@@ -588,11 +622,11 @@ public:
     using result_type = basic_result<_mutability, void_to_monostate_t<std::invoke_result_t<O, T, Args&&...>>, E>;
     if constexpr (std::is_void_v<std::invoke_result_t<O, T, Args&&...>>)
       return is_ok()
-                 ? std::invoke(std::forward<O>(op), std::move(std::get<success_t<T>>(storage_).get(), std::forward<Args>(args)...)), static_cast<result_type>(success_t{})
+                 ? mitamagic::invoke(std::forward<O>(op), std::move(std::get<success_t<T>>(storage_).get(), std::forward<Args>(args)...)), static_cast<result_type>(success_t{})
                  : static_cast<result_type>(failure_t{std::move(std::get<failure_t<E>>(storage_).get())});
     else
       return is_ok()
-                 ? static_cast<result_type>(success_t{std::invoke(std::forward<O>(op), std::move(std::get<success_t<T>>(storage_).get(), std::forward<Args>(args)...))})
+                 ? static_cast<result_type>(success_t{mitamagic::invoke(std::forward<O>(op), std::move(std::get<success_t<T>>(storage_).get(), std::forward<Args>(args)...))})
                  : static_cast<result_type>(failure_t{std::move(std::get<failure_t<E>>(storage_).get())});
   }
 
@@ -619,11 +653,11 @@ public:
     using result_type = basic_result<_mutability, void_to_monostate_t<std::invoke_result_t<O, Args&&...>>, E>;
     if constexpr (std::is_void_v<std::invoke_result_t<O, Args&&...>>)
       return is_ok()
-                 ? std::invoke(std::forward<O>(op), std::forward<Args>(args)...), static_cast<result_type>(success_t{})
+                 ? mitamagic::invoke(std::forward<O>(op), std::forward<Args>(args)...), static_cast<result_type>(success_t{})
                  : static_cast<result_type>(failure_t{std::move(std::get<failure_t<E>>(storage_).get())});
     else
       return is_ok()
-                 ? static_cast<result_type>(success_t{std::invoke(std::forward<O>(op), std::forward<Args>(args)...)})
+                 ? static_cast<result_type>(success_t{mitamagic::invoke(std::forward<O>(op), std::forward<Args>(args)...)})
                  : static_cast<result_type>(failure_t{std::move(std::get<failure_t<E>>(storage_).get())});
   }
 
@@ -651,9 +685,10 @@ public:
     std::common_type_t<std::invoke_result_t<Map, T>, std::invoke_result_t<Fallback, E>>>
   {
     using result_type = std::common_type_t<std::invoke_result_t<Map, T>, std::invoke_result_t<Fallback, E>>;
+    if (is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
     return is_ok()
-               ? static_cast<result_type>(std::invoke(std::forward<Map>(_map), std::get<success_t<T>>(storage_).get()))
-               : static_cast<result_type>(std::invoke(std::forward<Fallback>(_fallback), std::get<failure_t<E>>(storage_).get()));
+               ? static_cast<result_type>(mitamagic::invoke(std::forward<Map>(_map), std::get<success_t<T>>(storage_).get()))
+               : static_cast<result_type>(mitamagic::invoke(std::forward<Fallback>(_fallback), std::get<failure_t<E>>(storage_).get()));
   }
 
   /// @brief
@@ -679,9 +714,10 @@ public:
     std::common_type_t<std::invoke_result_t<Map, T>, std::invoke_result_t<Fallback, E>>>
   {
     using result_type = std::common_type_t<std::invoke_result_t<Map, T>, std::invoke_result_t<Fallback, E>>;
+    if (is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
     return is_ok()
-               ? static_cast<result_type>(std::invoke(std::forward<Map>(_map), std::get<success_t<T>>(storage_).get()))
-               : static_cast<result_type>(std::invoke(std::forward<Fallback>(_fallback), std::get<failure_t<E>>(storage_).get()));
+               ? static_cast<result_type>(mitamagic::invoke(std::forward<Map>(_map), std::get<success_t<T>>(storage_).get()))
+               : static_cast<result_type>(mitamagic::invoke(std::forward<Fallback>(_fallback), std::get<failure_t<E>>(storage_).get()));
   }
 
   /// @brief
@@ -707,9 +743,10 @@ public:
     std::common_type_t<std::invoke_result_t<Map, T>, std::invoke_result_t<Fallback, E>>>
   {
     using result_type = std::common_type_t<std::invoke_result_t<Map, T>, std::invoke_result_t<Fallback, E>>;
+    if (is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
     return is_ok()
-               ? static_cast<result_type>(std::invoke(std::forward<Map>(_map), std::move(std::get<success_t<T>>(storage_).get())))
-               : static_cast<result_type>(std::invoke(std::forward<Fallback>(_fallback), std::move(std::get<failure_t<E>>(storage_).get())));
+               ? static_cast<result_type>(mitamagic::invoke(std::forward<Map>(_map), std::move(std::get<success_t<T>>(storage_).get())))
+               : static_cast<result_type>(mitamagic::invoke(std::forward<Fallback>(_fallback), std::move(std::get<failure_t<E>>(storage_).get())));
   }
 
   /// @brief
@@ -731,11 +768,11 @@ public:
     using result_type = basic_result<_mutability, T, void_to_monostate_t<std::invoke_result_t<O, E, Args&&...>>>;
     if constexpr (std::is_void_v<std::invoke_result_t<O, E, Args&&...>>)
       return is_err()
-                 ? std::invoke(std::forward<O>(op), std::get<failure_t<E>>(storage_).get(), std::forward<Args>(args)...), static_cast<result_type>(failure_t{})
+                 ? mitamagic::invoke(std::forward<O>(op), std::get<failure_t<E>>(storage_).get(), std::forward<Args>(args)...), static_cast<result_type>(failure_t{})
                  : static_cast<result_type>(success_t{std::get<success_t<T>>(storage_).get()});
     else
       return is_err()
-                 ? static_cast<result_type>(failure_t{std::invoke(std::forward<O>(op), std::get<failure_t<E>>(storage_).get(), std::forward<Args>(args)...)})
+                 ? static_cast<result_type>(failure_t{mitamagic::invoke(std::forward<O>(op), std::get<failure_t<E>>(storage_).get(), std::forward<Args>(args)...)})
                  : static_cast<result_type>(success_t{std::get<success_t<T>>(storage_).get()});
   }
 
@@ -762,11 +799,11 @@ public:
     using result_type = basic_result<_mutability, T, void_to_monostate_t<std::invoke_result_t<O, Args&&...>>>;
     if constexpr (std::is_void_v<std::invoke_result_t<O, Args&&...>>)
       return is_err()
-                 ? std::invoke(std::forward<O>(op), std::forward<Args>(args)...), static_cast<result_type>(failure_t{})
+                 ? mitamagic::invoke(std::forward<O>(op), std::forward<Args>(args)...), static_cast<result_type>(failure_t{})
                  : static_cast<result_type>(success_t{std::get<success_t<T>>(storage_).get()});
     else
       return is_err()
-                 ? static_cast<result_type>(failure_t{std::invoke(std::forward<O>(op), std::forward<Args>(args)...)})
+                 ? static_cast<result_type>(failure_t{mitamagic::invoke(std::forward<O>(op), std::forward<Args>(args)...)})
                  : static_cast<result_type>(success_t{std::get<success_t<T>>(storage_).get()});
   }
 
@@ -789,11 +826,11 @@ public:
     using result_type = basic_result<_mutability, T, void_to_monostate_t<std::invoke_result_t<O, E, Args&&...>>>;
     if constexpr (std::is_void_v<std::invoke_result_t<O, E, Args&&...>>)
       return is_err()
-                 ? std::invoke(std::forward<O>(op), std::move(std::get<failure_t<E>>(storage_).get()), std::forward<Args>(args)...), static_cast<result_type>(failure_t{})
+                 ? mitamagic::invoke(std::forward<O>(op), std::move(std::get<failure_t<E>>(storage_).get()), std::forward<Args>(args)...), static_cast<result_type>(failure_t{})
                  : static_cast<result_type>(success_t{std::move(std::get<success_t<T>>(storage_).get())});
     else
       return is_err()
-                 ? static_cast<result_type>(failure_t{std::invoke(std::forward<O>(op), std::move(std::get<failure_t<E>>(storage_).get()), std::forward<Args>(args)...)})
+                 ? static_cast<result_type>(failure_t{mitamagic::invoke(std::forward<O>(op), std::move(std::get<failure_t<E>>(storage_).get()), std::forward<Args>(args)...)})
                  : static_cast<result_type>(success_t{std::move(std::get<success_t<T>>(storage_).get())});
   }
 
@@ -820,11 +857,11 @@ public:
     using result_type = basic_result<_mutability, T, void_to_monostate_t<std::invoke_result_t<O, Args&&...>>>;
     if constexpr (std::is_void_v<std::invoke_result_t<O, Args&&...>>)
       return is_err()
-                 ? std::invoke(std::forward<O>(op), std::forward<Args>(args)...), static_cast<result_type>(failure_t{})
+                 ? mitamagic::invoke(std::forward<O>(op), std::forward<Args>(args)...), static_cast<result_type>(failure_t{})
                  : static_cast<result_type>(success_t{std::move(std::get<success_t<T>>(storage_).get())});
     else
       return is_err()
-                 ? static_cast<result_type>(failure_t{std::invoke(std::forward<O>(op), std::forward<Args>(args)...)})
+                 ? static_cast<result_type>(failure_t{mitamagic::invoke(std::forward<O>(op), std::forward<Args>(args)...)})
                  : static_cast<result_type>(success_t{std::move(std::get<success_t<T>>(storage_).get())});
   }
 
@@ -844,7 +881,7 @@ public:
   {
     using result_type = std::invoke_result_t<O, T, Args&&...>;
     return is_ok()
-               ? std::invoke(std::forward<O>(op), std::get<success_t<T>>(storage_).get(), std::forward<Args>(args)...)
+               ? mitamagic::invoke(std::forward<O>(op), std::get<success_t<T>>(storage_).get(), std::forward<Args>(args)...)
                : static_cast<result_type>(failure_t{std::get<failure_t<E>>(storage_).get()});
   }
 
@@ -864,7 +901,7 @@ public:
   {
     using result_type = std::invoke_result_t<O, T, Args&&...>;
     return is_ok()
-               ? std::invoke(std::forward<O>(op), std::move(std::get<success_t<T>>(storage_).get()), std::forward<Args>(args)...)
+               ? mitamagic::invoke(std::forward<O>(op), std::move(std::get<success_t<T>>(storage_).get()), std::forward<Args>(args)...)
                : static_cast<result_type>(failure_t{std::move(std::get<failure_t<E>>(storage_).get())});
   }
 
@@ -883,8 +920,9 @@ public:
     std::invoke_result_t<O, E, Args&&...>>
   {
     using result_type = std::invoke_result_t<O, E, Args&&...>;
+    if (is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
     return is_err()
-               ? std::invoke(std::forward<O>(op), std::get<failure_t<E>>(storage_).get(), std::forward<Args>(args)...)
+               ? mitamagic::invoke(std::forward<O>(op), std::get<failure_t<E>>(storage_).get(), std::forward<Args>(args)...)
                : static_cast<result_type>(success_t{std::get<success_t<T>>(storage_).get()});
   }
 
@@ -903,8 +941,9 @@ public:
     std::invoke_result_t<O, E, Args&&...>>
   {
     using result_type = std::invoke_result_t<O, E, Args&&...>;
+    if (is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
     return is_err()
-               ? std::invoke(std::forward<O>(op), std::get<failure_t<E>>(std::move(storage_)).get(), std::forward<Args>(args)...)
+               ? mitamagic::invoke(std::forward<O>(op), std::get<failure_t<E>>(std::move(storage_)).get(), std::forward<Args>(args)...)
                : static_cast<result_type>(success_t{std::get<success_t<T>>(std::move(storage_)).get()});
   }
 
@@ -920,6 +959,51 @@ public:
                               : static_cast<result_type>(success_t{res.unwrap()});
   }
 
+  /// @brief
+  ///   Returns `res` if the result is success_t, otherwise; returns the failure value of self.
+  ///
+  /// @note
+  ///   Moves the contained value out of `res`.
+  template <mutability _mu, class U>
+  constexpr decltype(auto) conj(basic_result<_mu, U, E>&& res) const&
+  {
+    using result_type = basic_result<_mutability && _mu, U, E>;
+    return this->is_err()
+               ? static_cast<result_type>(failure_t{std::get<failure_t<E>>(storage_).get()})
+               : res.is_err() ? static_cast<result_type>(failure_t{std::get<failure_t<E>>(std::move(res.storage_)).get()})
+                              : static_cast<result_type>(success_t{std::get<success_t<U>>(std::move(res.storage_)).get()});
+  }
+
+  /// @brief
+  ///   Returns `res` if the result is success_t, otherwise; returns the failure value of self.
+  ///
+  /// @note
+  ///   Consumes self, moving the failure value out of self.
+  template <mutability _mu, class U>
+  constexpr decltype(auto) conj(basic_result<_mu, U, E> const& res) &&
+  {
+    using result_type = basic_result<_mutability && _mu, U, E>;
+    return this->is_err()
+               ? static_cast<result_type>(failure_t{std::get<failure_t<E>>(std::move(storage_)).get()})
+               : res.is_err() ? static_cast<result_type>(failure_t{res.unwrap_err()})
+                              : static_cast<result_type>(success_t{res.unwrap()});
+  }
+
+  /// @brief
+  ///   Returns `res` if the result is success_t, otherwise; returns the failure value of self.
+  ///
+  /// @note
+  ///   Consumes both self and `res`, moving whichever value is returned.
+  template <mutability _mu, class U>
+  constexpr decltype(auto) conj(basic_result<_mu, U, E>&& res) &&
+  {
+    using result_type = basic_result<_mutability && _mu, U, E>;
+    return this->is_err()
+               ? static_cast<result_type>(failure_t{std::get<failure_t<E>>(std::move(storage_)).get()})
+               : res.is_err() ? static_cast<result_type>(failure_t{std::get<failure_t<E>>(std::move(res.storage_)).get()})
+                              : static_cast<result_type>(success_t{std::get<success_t<U>>(std::move(res.storage_)).get()});
+  }
+
   /// @brief
   ///   Returns `res` if the result is success, otherwise; returns the failure value of self.
   template <mutability _mu, class U>
@@ -928,6 +1012,30 @@ public:
     return this->conj(res);
   }
 
+  /// @brief
+  ///   Returns `res` if the result is success, otherwise; returns the failure value of self.
+  template <mutability _mu, class U>
+  constexpr decltype(auto) operator&&(basic_result<_mu, U, E>&& res) const&
+  {
+    return this->conj(std::move(res));
+  }
+
+  /// @brief
+  ///   Returns `res` if the result is success, otherwise; returns the failure value of self.
+  template <mutability _mu, class U>
+  constexpr decltype(auto) operator&&(basic_result<_mu, U, E> const& res) &&
+  {
+    return std::move(*this).conj(res);
+  }
+
+  /// @brief
+  ///   Returns `res` if the result is success, otherwise; returns the failure value of self.
+  template <mutability _mu, class U>
+  constexpr decltype(auto) operator&&(basic_result<_mu, U, E>&& res) &&
+  {
+    return std::move(*this).conj(std::move(res));
+  }
+
   /// @brief
   ///   Returns res if the result is failure, otherwise returns the success value of self.
   ///
@@ -960,6 +1068,75 @@ public:
     return this->disj(res);
   }
 
+  /// @brief
+  ///   Returns res if the result is failure, otherwise returns the success value of self.
+  ///
+  /// @note
+  ///   Moves the contained value out of `res`.
+  template <mutability _mut, class F>
+  constexpr decltype(auto) disj(basic_result<_mut, T, F>&& res) const&
+  {
+    using result_type = basic_result<_mutability, T, F>;
+    return this->is_ok()
+               ? static_cast<result_type>(success_t{std::get<success_t<T>>(storage_).get()})
+               : res.is_ok() ? static_cast<result_type>(success_t{std::get<success_t<T>>(std::move(res.storage_)).get()})
+                             : static_cast<result_type>(failure_t{std::get<failure_t<F>>(std::move(res.storage_)).get()});
+  }
+
+  /// @brief
+  ///   Returns res if the result is failure, otherwise returns the success value of self.
+  ///
+  /// @note
+  ///   Consumes self, moving the success value out of self.
+  template <mutability _mut, class F>
+  constexpr decltype(auto) disj(basic_result<_mut, T, F> const& res) &&
+  {
+    using result_type = basic_result<_mutability, T, F>;
+    return this->is_ok()
+               ? static_cast<result_type>(success_t{std::get<success_t<T>>(std::move(storage_)).get()})
+               : res.is_ok() ? static_cast<result_type>(success_t{res.unwrap()})
+                             : static_cast<result_type>(failure_t{res.unwrap_err()});
+  }
+
+  /// @brief
+  ///   Returns res if the result is failure, otherwise returns the success value of self.
+  ///
+  /// @note
+  ///   Consumes both self and `res`, moving whichever value is returned.
+  template <mutability _mut, class F>
+  constexpr decltype(auto) disj(basic_result<_mut, T, F>&& res) &&
+  {
+    using result_type = basic_result<_mutability, T, F>;
+    return this->is_ok()
+               ? static_cast<result_type>(success_t{std::get<success_t<T>>(std::move(storage_)).get()})
+               : res.is_ok() ? static_cast<result_type>(success_t{std::get<success_t<T>>(std::move(res.storage_)).get()})
+                             : static_cast<result_type>(failure_t{std::get<failure_t<F>>(std::move(res.storage_)).get()});
+  }
+
+  /// @brief
+  ///   Returns res if the result is failure, otherwise returns the success value of self.
+  template <mutability _mut, class F>
+  constexpr decltype(auto) operator||(basic_result<_mut, T, F>&& res) const&
+  {
+    return this->disj(std::move(res));
+  }
+
+  /// @brief
+  ///   Returns res if the result is failure, otherwise returns the success value of self.
+  template <mutability _mut, class F>
+  constexpr decltype(auto) operator||(basic_result<_mut, T, F> const& res) &&
+  {
+    return std::move(*this).disj(res);
+  }
+
+  /// @brief
+  ///   Returns res if the result is failure, otherwise returns the success value of self.
+  template <mutability _mut, class F>
+  constexpr decltype(auto) operator||(basic_result<_mut, T, F>&& res) &&
+  {
+    return std::move(*this).disj(std::move(res));
+  }
+
   /// @brief
   ///   Unwraps a result, yielding the content of an success_t.
   ///   Else, it returns optb.
@@ -974,8 +1151,9 @@ public:
   ///   which is lazily evaluated.
   template <class U,
             where<meta::has_common_type<T, U&&>> = required>
-  decltype(auto) unwrap_or(U&& optb) const& noexcept
+  constexpr decltype(auto) unwrap_or(U&& optb) const& noexcept
   {
+    if (is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
     return is_ok() ? std::get<success_t<T>>(storage_).get()
                    : std::forward<U>(optb);
   }
@@ -994,7 +1172,8 @@ public:
   ///   which is lazily evaluated.
   template <class U,
             where<meta::has_common_type<std::remove_reference_t<T>&&, U&&>> = required>
-  decltype(auto) unwrap_or(U&& optb) && noexcept {
+  constexpr decltype(auto) unwrap_or(U&& optb) && noexcept {
+    if (is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
     return is_ok() ? std::move(std::get<success_t<T>>(storage_).get())
                    : std::forward<U>(optb);
   }
@@ -1012,12 +1191,13 @@ public:
   ///     - `std::is_invocable_r_v<T, O>` is true then; it invoke `op` without value,
   ///     - otherwise; static_assert.
   template <class O>
+  constexpr
   std::enable_if_t<
     std::disjunction_v<
       std::is_invocable_r<T, O, E>,
       std::is_invocable_r<T, O>>,
   T>
-  unwrap_or_else(O && op) const
+  unwrap_or_else(O && op) const&
     noexcept(
       std::disjunction_v<
         std::conjunction<
@@ -1031,11 +1211,58 @@ public:
       >
     )
   {
+    if (is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
     if constexpr (std::is_invocable_r_v<T, O, E>) {
-      return is_ok() ? std::get<success_t<T>>(storage_).get() : std::invoke(std::forward<O>(op), std::get<failure_t<E>>(storage_).get());
+      return is_ok() ? std::get<success_t<T>>(storage_).get() : mitamagic::invoke(std::forward<O>(op), std::get<failure_t<E>>(storage_).get());
     }
     else if constexpr (std::is_invocable_r_v<T, O>) {
-      return is_ok() ? std::get<success_t<T>>(storage_).get() : std::invoke(std::forward<O>(op));
+      return is_ok() ? std::get<success_t<T>>(storage_).get() : mitamagic::invoke(std::forward<O>(op));
+    }
+    else {
+      static_assert([]{ return false; }(), "invalid argument: designated function object is not invocable");
+    }
+  }
+
+  /// @brief
+  ///   Unwraps a result, yielding the content of an success.
+  ///   Consumes self, moving the contained value out of it.
+  ///
+  /// @requires
+  ///   { std::invoke(op, unwrap_err()) } -> ConvertibleTo<T> ||
+  ///   { std::invoke(op) } -> ConvertibleTo<T>
+  ///
+  /// @note
+  ///   If the value is an failure then;
+  ///     - `std::is_invocable_r_v<T, O, E&&>` is true then; it invoke `op` with its value or,
+  ///     - `std::is_invocable_r_v<T, O>` is true then; it invoke `op` without value,
+  ///     - otherwise; static_assert.
+  template <class O>
+  constexpr
+  std::enable_if_t<
+    std::disjunction_v<
+      std::is_invocable_r<T, O, E&&>,
+      std::is_invocable_r<T, O>>,
+  T>
+  unwrap_or_else(O && op) &&
+    noexcept(
+      std::disjunction_v<
+        std::conjunction<
+          std::is_invocable_r<T, O, E&&>,
+          std::is_nothrow_invocable_r<T, O, E&&>
+        >,
+        std::conjunction<
+          std::is_invocable_r<T, O>,
+          std::is_nothrow_invocable_r<T, O>
+        >
+      >
+    )
+  {
+    if (is_err()) MITAMA_ERROR_RETURN_TRACE_CLOSE();
+    if constexpr (std::is_invocable_r_v<T, O, E&&>) {
+      return is_ok() ? std::get<success_t<T>>(std::move(storage_)).get() : mitamagic::invoke(std::forward<O>(op), std::get<failure_t<E>>(std::move(storage_)).get());
+    }
+    else if constexpr (std::is_invocable_r_v<T, O>) {
+      return is_ok() ? std::get<success_t<T>>(std::move(storage_)).get() : mitamagic::invoke(std::forward<O>(op));
     }
     else {
       static_assert([]{ return false; }(), "invalid argument: designated function object is not invocable");
@@ -1047,6 +1274,7 @@ public:
   ///
   /// @panics
   ///   Panics if the value is an failure, with a panic message provided by the failure's value.
+  constexpr
   force_add_const_t<T>&
   unwrap() const& {
     if constexpr (trait::formattable_element<E>::value) {
@@ -1072,6 +1300,7 @@ public:
   ///
   /// @panics
   ///   Panics if the value is an failure, with a panic message provided by the failure's value.
+  constexpr
   std::conditional_t<is_mut_v<_mutability>, T&, force_add_const_t<T>&>
   unwrap() & {
     if constexpr (trait::formattable_element<E>::value) {
@@ -1097,6 +1326,7 @@ public:
   ///
   /// @panics
   ///   Panics if the value is an success, with a panic message provided by the success's value.
+  constexpr
   force_add_const_t<E>&
   unwrap_err() const& {
     if constexpr (trait::formattable_element<T>::value) {
@@ -1122,6 +1352,7 @@ public:
   ///
   /// @panics
   ///   Panics if the value is an success, with a panic message provided by the success's value.
+  constexpr
   std::conditional_t<is_mut_v<_mutability>, E&, force_add_const_t<E>&>
   unwrap_err() & {
     if constexpr (trait::formattable_element<T>::value) {
@@ -1147,6 +1378,7 @@ public:
   ///
   /// @panics
   ///   Panics if the value is an failure, with a panic message including the passed message, and the content of the failure.
+  constexpr
   force_add_const_t<T>&
   expect(std::string_view msg) const& {
     if ( is_err() )
@@ -1160,6 +1392,7 @@ public:
   ///
   /// @panics
   ///   Panics if the value is an failure, with a panic message including the passed message, and the content of the failure.
+  constexpr
   decltype(auto)
   expect(std::string_view msg) & {
     if ( is_err() )
@@ -1173,6 +1406,7 @@ public:
   ///
   /// @panics
   ///   Panics if the value is an success, with a panic message including the passed message, and the content of the success.
+  constexpr
   force_add_const_t<E>&
   expect_err(std::string_view msg) const& {
     if ( is_ok() )
@@ -1186,6 +1420,7 @@ public:
   ///
   /// @panics
   ///   Panics if the value is an success, with a panic message including the passed message, and the content of the success.
+  constexpr
   decltype(auto)
   expect_err(std::string_view msg) & {
     if ( is_ok() )
@@ -1199,7 +1434,15 @@ public:
   std::enable_if_t<std::is_invocable_v<F&&, T>>
   and_finally(F&& f) const& {
     if (this->is_ok())
-      std::invoke(std::forward<F>(f), unwrap());
+      mitamagic::invoke(std::forward<F>(f), unwrap());
+  }
+
+  template <class F>
+  constexpr
+  std::enable_if_t<std::is_invocable_v<F&&, T&&>>
+  and_finally(F&& f) && {
+    if (this->is_ok())
+      mitamagic::invoke(std::forward<F>(f), std::get<success_t<T>>(std::move(storage_)).get());
   }
 
   template <class F>
@@ -1207,7 +1450,15 @@ public:
   std::enable_if_t<std::is_invocable_v<F&&, E>>
   or_finally(F&& f) const& {
     if (this->is_err())
-      std::invoke(std::forward<F>(f), unwrap_err());
+      mitamagic::invoke(std::forward<F>(f), unwrap_err());
+  }
+
+  template <class F>
+  constexpr
+  std::enable_if_t<std::is_invocable_v<F&&, E&&>>
+  or_finally(F&& f) && {
+    if (this->is_err())
+      mitamagic::invoke(std::forward<F>(f), std::get<failure_t<E>>(std::move(storage_)).get());
   }
 
   template <class F>
@@ -1221,11 +1472,11 @@ public:
   {
     if constexpr (std::is_invocable_v<F, T&>) {
       if (is_ok())
-        std::invoke(std::forward<F>(f), unwrap());
+        mitamagic::invoke(std::forward<F>(f), unwrap());
     }
     else {
       if (is_ok())
-        std::invoke(std::forward<F>(f));
+        mitamagic::invoke(std::forward<F>(f));
     }
     return *this;
   }
@@ -1240,11 +1491,11 @@ public:
   {
     if constexpr (std::is_invocable_v<F, T const&>) {
       if (is_ok())
-        std::invoke(std::forward<F>(f), unwrap());
+        mitamagic::invoke(std::forward<F>(f), unwrap());
     }
     else {
       if (is_ok())
-        std::invoke(std::forward<F>(f));
+        mitamagic::invoke(std::forward<F>(f));
     }
     return *this;
   }
@@ -1259,11 +1510,11 @@ public:
   {
     if constexpr (std::is_invocable_v<F, T&&>) {
       if (is_ok())
-        std::invoke(std::forward<F>(f), unwrap());
+        mitamagic::invoke(std::forward<F>(f), unwrap());
     }
     else {
       if (is_ok())
-        std::invoke(std::forward<F>(f));
+        mitamagic::invoke(std::forward<F>(f));
     }
     return std::move(*this);
   }
@@ -1277,11 +1528,11 @@ public:
   or_peek(F&& f) & {
     if constexpr (std::is_invocable_v<F, E&>) {
       if (is_err())
-        std::invoke(std::forward<F>(f), unwrap_err());
+        mitamagic::invoke(std::forward<F>(f), unwrap_err());
     }
     else {
       if (is_err())
-        std::invoke(std::forward<F>(f));
+        mitamagic::invoke(std::forward<F>(f));
     }
     return *this;
   }
@@ -1296,11 +1547,11 @@ public:
   {
     if constexpr (std::is_invocable_v<F, E const&>) {
       if (is_err())
-        std::invoke(std::forward<F>(f), unwrap_err());
+        mitamagic::invoke(std::forward<F>(f), unwrap_err());
     }
     else {
       if (is_err())
-        std::invoke(std::forward<F>(f));
+        mitamagic::invoke(std::forward<F>(f));
     }
     return *this;
   }
@@ -1315,11 +1566,11 @@ public:
   {
     if constexpr (std::is_invocable_v<F, E&&>) {
       if (is_err())
-        std::invoke(std::forward<F>(f), unwrap_err());
+        mitamagic::invoke(std::forward<F>(f), unwrap_err());
     }
     else {
       if (is_err())
-        std::invoke(std::forward<F>(f));
+        mitamagic::invoke(std::forward<F>(f));
     }
     return std::move(*this);
   }
@@ -1631,9 +1882,25 @@ public:
             basic_result<_mutability, T, std::shared_ptr<anyhow::error>>>
   {
     return this->map_err([&](auto err) -> std::shared_ptr<anyhow::error> {
-      return err->context(std::invoke(ctx));
+      return err->context(mitamagic::invoke(ctx));
     });
   }
+
+  /// @brief
+  ///   `with_context(ctx)` allocating the error chain, and the errors created by `ctx`,
+  ///   from the memory resource of `alloc`.
+  ///
+  /// @note
+  ///   The resource must outlive the returned error.
+  template <class U, class Ctx>
+  auto with_context(std::allocator_arg_t, std::pmr::polymorphic_allocator<U> const& alloc, Ctx ctx)
+    -> std::enable_if_t<
+            std::is_invocable_r_v<std::shared_ptr<anyhow::error>, Ctx>,
+            basic_result<_mutability, T, std::shared_ptr<anyhow::error>>>
+  {
+    anyhow::resource_scope scope{ *alloc.resource() };
+    return this->with_context(std::move(ctx));
+  }
 };
 
   template <mutability _, class T, class E, class U>
@@ -1812,6 +2079,7 @@ public:
             using Err = ::mitama::failure_t<                                              \
                 ::mitama::meta::remove_cvr_t<decltype(result)>::err_type                  \
             >;                                                                            \
+            MITAMA_ERROR_RETURN_TRACE_PUSH();                                             \
             return ::std::get<Err>(std::forward<decltype(result)>(result).into_storage());\
         }                                                                                 \
         using Ok = ::mitama::success_t<                                                   \
@@ -0,0 +1,105 @@
+#ifndef MITAMA_SYS_ERROR_HPP
+#define MITAMA_SYS_ERROR_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace mitama::_sys_error_detail {
+  // strerror_r is the XSI version (returning int) or the GNU version (returning char*)
+  inline char const* strerror_result(int ret, char const* buf) noexcept {
+    // ERANGE: truncated to the buffer
+    return ret == 0 || ret == ERANGE ? buf : nullptr;
+  }
+  inline char const* strerror_result(char const* ret, char const*) noexcept {
+    return ret;
+  }
+
+  inline char const* strerror(int code, char* buf, std::size_t size) noexcept {
+#if defined(_WIN32)
+    return ::strerror_s(buf, size, code) == 0 ? buf : nullptr;
+#else
+    return strerror_result(::strerror_r(code, buf, size), buf);
+#endif
+  }
+}
+
+namespace mitama {
+
+/// @brief
+///   An `errno` value.
+///
+/// @note
+///   Unlike `std::error_code`, it has no category pointer and no virtual `message()`:
+///   it is 4 bytes and trivially copyable, so `result<int, sys_error>` is 8 bytes and returned in registers.
+///   The message is looked up only on request, with `strerror_r`.
+class sys_error {
+  int code_;
+public:
+  sys_error() = default;
+  constexpr explicit sys_error(int code) noexcept: code_(code) {}
+  constexpr sys_error(std::errc code) noexcept: code_(static_cast<int>(code)) {}
+
+  /// @brief
+  ///   Converts from an error code of the system or generic category.
+  ///   Codes of other categories are converted through their default error condition.
+  explicit sys_error(std::error_code const& ec) noexcept
+    : code_(ec.category() == std::system_category() || ec.category() == std::generic_category()
+            ? ec.value() : ec.default_error_condition().value()) {}
+
+  /// @brief
+  ///   The current value of `errno`.
+  static sys_error last() noexcept { return sys_error{errno}; }
+
+  constexpr int code() const noexcept { return code_; }
+
+  /// @brief
+  ///   The error as a `std::error_code` of the system category.
+  std::error_code error_code() const noexcept { return {code_, std::system_category()}; }
+  operator std::error_code() const noexcept { return error_code(); }
+
+  /// @brief
+  ///   Writes the message into `buf` (truncated to its size) and returns it.
+  std::string_view message(char* buf, std::size_t size) const noexcept {
+    if (size == 0) return {};
+    buf[0] = '\0';
+    auto msg = _sys_error_detail::strerror(code_, buf, size);
+    if (msg == nullptr) return {};
+    // the GNU version may return a static string instead
+    if (msg != buf) {
+      auto const len = std::min(std::strlen(msg), size - 1);
+      std::memcpy(buf, msg, len);
+      buf[len] = '\0';
+    }
+    return {buf, std::strlen(buf)};
+  }
+
+  template <std::size_t N>
+  std::string_view message(char (&buf)[N]) const noexcept { return message(buf, N); }
+
+  std::string message() const {
+    char buf[256];
+    return std::string(message(buf));
+  }
+
+  friend constexpr bool operator==(sys_error lhs, sys_error rhs) noexcept { return lhs.code_ == rhs.code_; }
+  friend constexpr bool operator!=(sys_error lhs, sys_error rhs) noexcept { return lhs.code_ != rhs.code_; }
+
+  friend std::ostream& operator<<(std::ostream& os, sys_error const& err) {
+    char buf[256];
+    return os << err.message(buf);
+  }
+};
+
+static_assert(std::is_trivially_copyable_v<sys_error>);
+static_assert(sizeof(sys_error) == sizeof(int));
+
+}
+
+#endif
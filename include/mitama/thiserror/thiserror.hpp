@@ -44,7 +44,7 @@ namespace mitama::thiserror { inline namespace v1 {
     }
 
     std::shared_ptr<mitama::anyhow::error> context(std::shared_ptr<mitama::anyhow::error> ctx) override {
-      return std::make_shared<mitama::anyhow::errors>(std::enable_shared_from_this<Self>::shared_from_this(), std::move(ctx));
+      return _anyhow_detail::make_error<mitama::anyhow::errors>(std::enable_shared_from_this<Self>::shared_from_this(), std::move(ctx));
     }
 
     std::string what() const override {
@@ -0,0 +1,144 @@
+#ifndef MITAMA_VIEWS_HPP
+#define MITAMA_VIEWS_HPP
+#include <mitama/maybe/maybe.hpp>
+#include <mitama/result/result.hpp>
+
+/// Lazy range adaptors over ranges of `basic_result` and `maybe` (requires C++20 ranges).
+///
+/// Every adaptor is a `std::views` range adaptor closure, so they compose with `std::views`:
+///
+///   records | mitama::views::oks | std::views::take(10)
+///
+/// Projections of lvalue elements yield references into the underlying storage;
+/// projections of prvalue elements (e.g. produced by `std::views::transform`) yield values.
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace mitama::_views_detail {
+  template <class T>
+  using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+  /// value of a (checked) success/just element, a reference if the element is an lvalue
+  template <class Elem>
+  constexpr decltype(auto) value_of(Elem&& elem) {
+    using self = remove_cvref_t<Elem>;
+    if constexpr (is_result_v<self>) {
+      using ref = decltype(std::get<success_t<typename self::ok_type>>(std::forward<Elem>(elem).into_storage()).get());
+      using ret = std::conditional_t<
+        std::is_lvalue_reference_v<Elem> || std::is_reference_v<typename self::ok_type>,
+        ref, remove_cvref_t<ref>>;
+      return static_cast<ret>(std::get<success_t<typename self::ok_type>>(std::forward<Elem>(elem).into_storage()).get());
+    }
+    else {
+      return std::forward<Elem>(elem).unwrap();
+    }
+  }
+
+  /// value of a (checked) failure element, a reference if the element is an lvalue
+  template <class Elem>
+  constexpr decltype(auto) error_of(Elem&& elem) {
+    using self = remove_cvref_t<Elem>;
+    using ref = decltype(std::get<failure_t<typename self::err_type>>(std::forward<Elem>(elem).into_storage()).get());
+    using ret = std::conditional_t<
+      std::is_lvalue_reference_v<Elem> || std::is_reference_v<typename self::err_type>,
+      ref, remove_cvref_t<ref>>;
+    return static_cast<ret>(std::get<failure_t<typename self::err_type>>(std::forward<Elem>(elem).into_storage()).get());
+  }
+
+  struct has_value_fn {
+    template <class Elem>
+    constexpr bool operator()(Elem const& elem) const {
+      if constexpr (is_result_v<Elem>) return elem.is_ok();
+      else return elem.is_just();
+    }
+  };
+
+  struct is_err_fn {
+    template <class Elem, std::enable_if_t<is_result_v<Elem>, bool> = false>
+    constexpr bool operator()(Elem const& elem) const { return elem.is_err(); }
+  };
+
+  struct value_fn {
+    template <class Elem>
+    constexpr decltype(auto) operator()(Elem&& elem) const { return value_of(std::forward<Elem>(elem)); }
+  };
+
+  struct error_fn {
+    template <class Elem>
+    constexpr decltype(auto) operator()(Elem&& elem) const { return error_of(std::forward<Elem>(elem)); }
+  };
+
+  template <class U>
+  struct unwrap_or_fn {
+    U def;
+
+    template <class Elem>
+    constexpr auto operator()(Elem&& elem) const
+      -> std::common_type_t<remove_cvref_t<decltype(value_of(std::declval<Elem>()))>, U>
+    {
+      if (has_value_fn{}(elem)) return value_of(std::forward<Elem>(elem));
+      else return def;
+    }
+  };
+
+  template <class F>
+  struct transform_ok_fn {
+    F f;
+
+    template <class Elem>
+    constexpr auto operator()(Elem&& elem) const {
+      return std::forward<Elem>(elem).map(f);
+    }
+  };
+}
+
+namespace mitama::views {
+
+/// @brief
+///   Success values of a range of results; failures are skipped.
+inline constexpr auto oks
+  = std::views::filter(_views_detail::has_value_fn{})
+  | std::views::transform(_views_detail::value_fn{});
+
+/// @brief
+///   Failure values of a range of results; successes are skipped.
+inline constexpr auto errs
+  = std::views::filter(_views_detail::is_err_fn{})
+  | std::views::transform(_views_detail::error_fn{});
+
+/// @brief
+///   Values of a range of maybes; nothings are skipped.
+inline constexpr auto justs
+  = std::views::filter(_views_detail::has_value_fn{})
+  | std::views::transform(_views_detail::value_fn{});
+
+/// @brief
+///   Success values (or just values) of the elements up to the first failure (or nothing).
+inline constexpr auto take_while_ok
+  = std::views::take_while(_views_detail::has_value_fn{})
+  | std::views::transform(_views_detail::value_fn{});
+
+/// @brief
+///   Success values (or just values) of the elements, with `def` in place of failures (or nothings).
+///
+/// @note
+///   Yields values, as the default is not part of the underlying range.
+template <class U>
+constexpr auto unwrap_or(U&& def) {
+  return std::views::transform(_views_detail::unwrap_or_fn<std::decay_t<U>>{std::forward<U>(def)});
+}
+
+/// @brief
+///   Applies `map(f)` to each element.
+template <class F>
+constexpr auto transform_ok(F&& f) {
+  return std::views::transform(_views_detail::transform_ok_fn<std::decay_t<F>>{std::forward<F>(f)});
+}
+
+}
+#endif
+
+#endif
@@ -0,0 +1,235 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include <mitama/result/result.hpp>
+#include <mitama/maybe/maybe.hpp>
+#include <mitama/anyhow/anyhow.hpp>
+#include <mitama/thiserror/thiserror.hpp>
+#include <mitama/memory/arena.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+
+// Replaces the global allocation functions with counting versions.
+// Only the allocations made inside `allocations_in` are counted,
+// so Catch2's own bookkeeping never shows up in the numbers.
+namespace {
+  std::size_t allocations = 0;
+  bool counting = false;
+
+  template <class F>
+  std::size_t allocations_in(F&& f) {
+    allocations = 0;
+    counting = true;
+    static_cast<void>(std::forward<F>(f)());
+    counting = false;
+    return allocations;
+  }
+}
+
+void* operator new(std::size_t size) {
+  if (counting) ++allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+using namespace mitama;
+namespace anyhow = mitama::anyhow;
+using namespace std::literals;
+
+namespace {
+  constexpr auto inc = [](int v) { return v + 1; };
+  constexpr auto to_ok = [](int v) -> mut_result<int, int> { return success(v + 1); };
+  constexpr auto to_err = [](int v) -> mut_result<int, int> { return failure(v + 1); };
+  constexpr auto to_just = [](int v) -> maybe<int> { return just(v + 1); };
+  constexpr auto to_nothing = []() -> maybe<int> { return nothing; };
+}
+
+TEST_CASE("basic_result observers do not allocate", "[alloc][result]"){
+  mut_result<int, int> ok = success(1);
+  mut_result<int, int> err = failure(2);
+
+  REQUIRE(allocations_in([&]{ return ok.is_ok() && err.is_err(); }) == 0);
+  REQUIRE(allocations_in([&]{ return ok.ok(); }) == 0);
+  REQUIRE(allocations_in([&]{ return err.err(); }) == 0);
+  REQUIRE(allocations_in([&]{ return ok.as_ref(); }) == 0);
+  REQUIRE(allocations_in([&]{ return ok.as_mut(); }) == 0);
+  REQUIRE(allocations_in([&]{ return ok.unwrap(); }) == 0);
+  REQUIRE(allocations_in([&]{ return err.unwrap_err(); }) == 0);
+  REQUIRE(allocations_in([&]{ return ok.expect("never"); }) == 0);
+  REQUIRE(allocations_in([&]{ return err.expect_err("never"); }) == 0);
+  REQUIRE(allocations_in([&]{ return err.unwrap_or(3); }) == 0);
+  REQUIRE(allocations_in([&]{ return err.unwrap_or_else(inc); }) == 0);
+  REQUIRE(allocations_in([&]{ return err.unwrap_or_default(); }) == 0);
+  REQUIRE(allocations_in([&]{ return ok == err; }) == 0);
+  REQUIRE(allocations_in([&]{ return ok < err; }) == 0);
+}
+
+TEST_CASE("basic_result combinators do not allocate", "[alloc][result]"){
+  mut_result<int, int> ok = success(1);
+  mut_result<int, int> err = failure(2);
+
+  REQUIRE(allocations_in([&]{ return ok.map(inc); }) == 0);
+  REQUIRE(allocations_in([&]{ return err.map_err(inc); }) == 0);
+  REQUIRE(allocations_in([&]{ return ok.map_or_else(inc, inc); }) == 0);
+  REQUIRE(allocations_in([&]{ return err.map_anything_else(inc); }) == 0);
+  REQUIRE(allocations_in([&]{ return ok.and_then(to_ok); }) == 0);
+  REQUIRE(allocations_in([&]{ return err.or_else(to_err); }) == 0);
+  REQUIRE(allocations_in([&]{ return ok.conj(err); }) == 0);
+  REQUIRE(allocations_in([&]{ return ok && err; }) == 0);
+  REQUIRE(allocations_in([&]{ return err.disj(ok); }) == 0);
+  REQUIRE(allocations_in([&]{ return err || ok; }) == 0);
+  REQUIRE(allocations_in([&]{ return ok.and_peek([](int&){}); }) == 0);
+  REQUIRE(allocations_in([&]{ return err.or_peek([](int&){}); }) == 0);
+  REQUIRE(allocations_in([&]{ ok.and_finally([](int){}); }) == 0);
+  REQUIRE(allocations_in([&]{ err.or_finally([](int){}); }) == 0);
+
+  mut_result<maybe<int>, int> nested = success(just(1));
+  REQUIRE(allocations_in([&]{ return nested.transpose(); }) == 0);
+}
+
+TEST_CASE("basic_result rvalue combinators do not allocate", "[alloc][result]"){
+  REQUIRE(allocations_in([]{ return mut_result<int, int>{success(1)}.map(inc); }) == 0);
+  REQUIRE(allocations_in([]{ return mut_result<int, int>{failure(1)}.map_err(inc); }) == 0);
+  REQUIRE(allocations_in([]{ return mut_result<int, int>{success(1)}.and_then(to_ok); }) == 0);
+  REQUIRE(allocations_in([]{ return mut_result<int, int>{failure(1)}.or_else(to_err); }) == 0);
+  REQUIRE(allocations_in([]{ return mut_result<int, int>{success(1)}.ok(); }) == 0);
+  REQUIRE(allocations_in([]{ return mut_result<int, int>{failure(1)}.err(); }) == 0);
+  REQUIRE(allocations_in([]{ return mut_result<int, int>{success(1)}.conj(mut_result<int, int>{success(2)}); }) == 0);
+  REQUIRE(allocations_in([]{ return mut_result<int, int>{failure(1)}.disj(mut_result<int, int>{success(2)}); }) == 0);
+  REQUIRE(allocations_in([]{ return mut_result<int, int>{failure(1)}.unwrap_or_else(inc); }) == 0);
+  REQUIRE(allocations_in([]{ return mut_result<int, int>{failure(1)}.unwrap_or_default(); }) == 0);
+}
+
+TEST_CASE("maybe observers do not allocate", "[alloc][maybe]"){
+  maybe<int> some = just(1);
+  maybe<int> none = nothing;
+
+  REQUIRE(allocations_in([&]{ return some.is_just() && none.is_nothing(); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.unwrap(); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.expect("never"); }) == 0);
+  REQUIRE(allocations_in([&]{ return none.unwrap_or(2); }) == 0);
+  REQUIRE(allocations_in([&]{ return none.unwrap_or_else([]{ return 2; }); }) == 0);
+  REQUIRE(allocations_in([&]{ return none.unwrap_or_default(); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.as_ref(); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.as_ref().cloned(); }) == 0);
+  REQUIRE(allocations_in([&]{ return some == none; }) == 0);
+  REQUIRE(allocations_in([&]{ return some < none; }) == 0);
+}
+
+TEST_CASE("maybe combinators do not allocate", "[alloc][maybe]"){
+  maybe<int> some = just(1);
+  maybe<int> none = nothing;
+
+  REQUIRE(allocations_in([&]{ return some.map(inc); }) == 0);
+  REQUIRE(allocations_in([&]{ return none.map_or(0, inc); }) == 0);
+  REQUIRE(allocations_in([&]{ return none.map_or_else([]{ return 0; }, inc); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.ok_or(0); }) == 0);
+  REQUIRE(allocations_in([&]{ return none.ok_or_else([]{ return 0; }); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.and_then(to_just); }) == 0);
+  REQUIRE(allocations_in([&]{ return none.or_else(to_nothing); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.filter([](int v){ return v == 1; }); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.conj(none); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.disj(none); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.xdisj(none); }) == 0);
+  REQUIRE(allocations_in([&]{ return some.and_peek([](int&){}); }) == 0);
+  REQUIRE(allocations_in([&]{ return none.or_peek([]{}); }) == 0);
+  REQUIRE(allocations_in([&]{ some.and_finally([](int){}); }) == 0);
+  REQUIRE(allocations_in([&]{ none.or_finally([]{}); }) == 0);
+
+  maybe<maybe<int>> nested = just(just(1));
+  REQUIRE(allocations_in([&]{ return nested.flatten(); }) == 0);
+  maybe<mut_result<int, int>> transposable = just(success(1));
+  REQUIRE(allocations_in([&]{ return transposable.transpose(); }) == 0);
+}
+
+TEST_CASE("maybe mutators do not allocate", "[alloc][maybe]"){
+  maybe<int> slot = nothing;
+
+  REQUIRE(allocations_in([&]{ return slot.get_or_emplace(1); }) == 0);
+  REQUIRE(allocations_in([&]{ return slot.get_or_emplace_with([]{ return 2; }); }) == 0);
+  REQUIRE(allocations_in([&]{ return slot.insert(3); }) == 0);
+  REQUIRE(allocations_in([&]{ return slot.replace(4); }) == 0);
+  REQUIRE(allocations_in([&]{ return slot.replace_with([]{ return 5; }); }) == 0);
+  REQUIRE(allocations_in([&]{ return slot.take_if([](int& v){ return v == 5; }); }) == 0);
+  REQUIRE(allocations_in([&]{ return slot.take(); }) == 0);
+}
+
+TEST_CASE("maybe of a heap-owning type moves instead of allocating", "[alloc][maybe]"){
+  auto const long_string = "a string long enough to defeat the small string optimization"s;
+  maybe<std::string> slot = just(long_string);
+
+  REQUIRE(allocations_in([&]{ return slot.take(); }) == 0);
+  REQUIRE(allocations_in([&]{ slot.insert(long_string); }) == 1);
+  REQUIRE(allocations_in([&]{ return slot.replace(std::string{}); }) == 0);
+  REQUIRE(allocations_in([&]{ return std::move(slot).or_else([]{ return maybe<std::string>{}; }); }) == 0);
+}
+
+TEST_CASE("anyhow allocates once per error node", "[alloc][anyhow]"){
+  REQUIRE(allocations_in([]{ return anyhow::anyhow("error"s); }) == 1);
+  REQUIRE(allocations_in([]{ return anyhow::result<int>{failure(anyhow::anyhow("error"s))}; }) == 1);
+}
+
+TEST_CASE("with_context allocates the context and one error chain", "[alloc][anyhow][context]"){
+  anyhow::result<int> ok = success(1);
+  anyhow::result<int> err = failure(anyhow::anyhow("error"s));
+
+  // the context function must not run for success
+  REQUIRE(allocations_in([&]{ return ok.with_context([]{ return anyhow::anyhow("context"s); }); }) == 0);
+  // context node + `errors` node + the vector holding both causes
+  REQUIRE(allocations_in([&]{ return err.with_context([]{ return anyhow::anyhow("context"s); }); }) == 3);
+}
+
+class alloc_test_error {
+  template <class S, class ...T>
+  using error = mitama::thiserror::error<S, T...>;
+public:
+  using disconnect
+    = error<MITAMA_ERROR("data store disconnected")>;
+  using redaction
+    = error<MITAMA_ERROR("for key `{0}` isn't available"), int>;
+};
+
+TEST_CASE("thiserror allocates once per error node", "[alloc][thiserror]"){
+  REQUIRE(allocations_in([]{ return anyhow::failure<alloc_test_error::disconnect>(); }) == 1);
+  REQUIRE(allocations_in([]{ return anyhow::failure<alloc_test_error::redaction>(42); }) == 1);
+
+  anyhow::result<int> err = anyhow::failure<alloc_test_error::disconnect>();
+  REQUIRE(allocations_in([&]{ return err.with_context([]{ return anyhow::anyhow("context"s); }); }) == 3);
+}
+
+TEST_CASE("errors of a resource_scope are allocated from its arena", "[alloc][anyhow][arena]"){
+  arena request(4096);
+  {
+    anyhow::resource_scope scope{request};
+    REQUIRE(allocations_in([]{ return anyhow::anyhow("error"s); }) == 0);
+    REQUIRE(allocations_in([]{ return anyhow::failure<alloc_test_error::redaction>(42); }) == 0);
+
+    anyhow::result<int> err = anyhow::failure<alloc_test_error::redaction>(42);
+    REQUIRE(allocations_in([&]{ return err.with_context([]{ return anyhow::anyhow("context"s); }); }) == 0);
+
+    auto chained = err.with_context([]{ return anyhow::anyhow("context"s); });
+    REQUIRE(request.owns(chained.unwrap_err().get()));
+    REQUIRE(chained.unwrap_err()->what() == "context\nfor key `42` isn't available\n");
+  }
+  // every error is gone: the whole request is released at once
+  REQUIRE(request.live() == 0);
+  request.reset();
+  REQUIRE(request.used() == 0);
+
+  // back to the global heap outside of the scope
+  REQUIRE(allocations_in([]{ return anyhow::anyhow("error"s); }) == 1);
+}
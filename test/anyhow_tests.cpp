@@ -1,4 +1,5 @@
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 
 #include <catch2/catch.hpp>
 
@@ -7,6 +8,12 @@
 #include <mitama/anyhow/anyhow.hpp>
 #include <mitama/thiserror/thiserror.hpp>
 
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+
 namespace anyhow = mitama::anyhow;
 using namespace std::literals;
 
@@ -69,3 +76,75 @@ TEST_CASE("data_store_error::redaction", "[anyhow][thiserror]") {
   REQUIRE(data.is_err());
   std::cout << res << std::endl;
 }
+
+namespace {
+  template <std::size_t N>
+  bool in_buffer(std::array<std::byte, N> const& buffer, void const* p) {
+    auto const* b = static_cast<std::byte const*>(p);
+    return buffer.data() <= b && b < buffer.data() + N;
+  }
+}
+
+TEST_CASE("errors allocated from a memory resource", "[anyhow][pmr]") {
+  std::array<std::byte, 4096> buffer;
+  std::pmr::monotonic_buffer_resource request(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+  std::pmr::polymorphic_allocator<std::byte> alloc{&request};
+
+  auto err = anyhow::anyhow(std::allocator_arg, alloc, "error"s);
+  REQUIRE(in_buffer(buffer, err.get()));
+  REQUIRE(err->what() == "error");
+
+  anyhow::result<int> data = anyhow::failure<data_store_error::redaction>(std::allocator_arg, alloc, "invalid key");
+  REQUIRE(in_buffer(buffer, data.unwrap_err().get()));
+
+  // the chain, and the context created inside, come from the resource as well
+  auto res = data.with_context(std::allocator_arg, alloc, [] { return anyhow::anyhow("data store failed."s); });
+  REQUIRE(in_buffer(buffer, res.unwrap_err().get()));
+  REQUIRE(res.unwrap_err()->what() == "data store failed.\nfor key `invalid key` isn't available\n");
+
+  // without the allocator, errors are back on the heap
+  REQUIRE_FALSE(in_buffer(buffer, anyhow::anyhow("error"s).get()));
+}
+
+TEST_CASE("errors::context appends to the resource of the chain", "[anyhow][pmr]") {
+  std::array<std::byte, 4096> buffer;
+  std::pmr::monotonic_buffer_resource request(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+  std::pmr::polymorphic_allocator<std::byte> alloc{&request};
+
+  auto chain = std::allocate_shared<anyhow::errors>(alloc, std::allocator_arg, alloc, anyhow::anyhow(std::allocator_arg, alloc, "root"s));
+  for (int i = 0; i < 8; ++i)
+    REQUIRE(chain->context(anyhow::anyhow(std::allocator_arg, alloc, "context"s)) == chain);
+  REQUIRE(chain->chain().size() == 9);
+  REQUIRE(chain->chain().back()->what() == "root");
+}
+
+TEST_CASE("errors allocated from a pool per thread", "[anyhow][pmr]") {
+  std::pmr::unsynchronized_pool_resource pool;
+  anyhow::resource_scope scope{pool};
+  for (int i = 0; i < 4; ++i) {
+    anyhow::result<int> data = anyhow::failure<data_store_error::disconnect>();
+    auto res = data.with_context([] { return anyhow::anyhow("data store failed."s); });
+    REQUIRE(res.unwrap_err()->what() == "data store failed.\ndata store disconnected\n");
+  }
+}
+
+TEST_CASE("heap vs monotonic_buffer_resource", "[anyhow][pmr][!benchmark]") {
+  // a request that fails and adds two contexts to the error on its way up
+  auto const request = [] {
+    anyhow::result<int> data = anyhow::failure<data_store_error::disconnect>();
+    return data
+      .with_context([] { return anyhow::anyhow("data store failed."s); })
+      .with_context([] { return anyhow::anyhow("request failed."s); });
+  };
+
+  BENCHMARK("heap") {
+    return request().is_err();
+  };
+
+  BENCHMARK("monotonic_buffer_resource") {
+    std::array<std::byte, 1024> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    anyhow::resource_scope scope{arena};
+    return request().is_err();
+  };
+}
@@ -0,0 +1,477 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch.hpp>
+
+#include <mitama/result/result.hpp>
+#include <mitama/maybe/maybe.hpp>
+#include <mitama/concurrency/atomic_maybe.hpp>
+#include <mitama/concurrency/lazy_result.hpp>
+#include <mitama/concurrency/memoize.hpp>
+#include <mitama/concurrency/hedge.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mitama;
+using namespace std::literals;
+
+TEST_CASE("atomic_maybe is set once", "[atomic_maybe]"){
+  atomic_maybe<std::string> config;
+  REQUIRE(config.get() == nothing);
+  REQUIRE_FALSE(config.is_set());
+
+  auto first = config.try_set("first"s);
+  REQUIRE(first == success("first"s));
+  REQUIRE(&first.unwrap() == &config.wait());
+  REQUIRE(config.get() == just("first"s));
+
+  // the rejected value is handed back
+  REQUIRE(config.try_set("second"s) == failure(already_set{"second"s}));
+  REQUIRE(config.wait() == "first");
+}
+
+TEST_CASE("atomic_maybe hands back move-only values", "[atomic_maybe]"){
+  atomic_maybe<std::unique_ptr<int>> cell;
+  REQUIRE(cell.try_set(std::make_unique<int>(1)).is_ok());
+  auto rejected = cell.try_set(std::make_unique<int>(2));
+  REQUIRE(*rejected.unwrap_err().value == 2);
+  REQUIRE(*cell.get().unwrap() == 1);
+}
+
+TEST_CASE("atomic_maybe publishes to waiting readers", "[atomic_maybe]"){
+  atomic_maybe<std::vector<int>> endpoints;
+  std::atomic<int> sum{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]{
+      for (int v: endpoints.wait()) sum += v;
+    });
+  }
+
+  // exactly one of the racing writers wins
+  std::atomic<int> wins{0};
+  std::vector<std::thread> writers;
+  for (int i = 0; i < 4; ++i) {
+    writers.emplace_back([&, i]{
+      if (endpoints.try_set(std::vector<int>{i, 1, 2, 3}).is_ok()) ++wins;
+    });
+  }
+  for (auto& t: writers) t.join();
+  for (auto& t: readers) t.join();
+
+  REQUIRE(wins == 1);
+  auto const& winner = endpoints.wait();
+  REQUIRE(sum == 4 * (winner[0] + 6));
+}
+
+TEST_CASE("atomic_maybe vs mutex-guarded maybe", "[atomic_maybe][!benchmark]"){
+  atomic_maybe<int> lock_free;
+  (void)lock_free.try_set(42);
+
+  std::mutex mutex;
+  maybe<int> guarded = just(42);
+
+  BENCHMARK("std::mutex + maybe<int>") {
+    std::lock_guard lock{mutex};
+    return guarded.unwrap_or(0);
+  };
+
+  BENCHMARK("atomic_maybe<int>::get") {
+    return lock_free.get().unwrap_or(0);
+  };
+}
+
+TEST_CASE("lazy_result runs its initializer once", "[lazy_result]"){
+  std::atomic<int> calls{0};
+  lazy_result config{[&]() -> result<std::string, int> {
+    ++calls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return success("loaded"s);
+  }};
+  static_assert(std::is_same_v<decltype(config.get()), result<std::string const&, int>>);
+  REQUIRE_FALSE(config.is_initialized());
+
+  std::vector<std::thread> threads;
+  std::atomic<int> loaded{0};
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&]{
+      if (config.get() == success("loaded"s)) ++loaded;
+    });
+  }
+  for (auto& t: threads) t.join();
+
+  REQUIRE(calls == 1);
+  REQUIRE(loaded == 8);
+  REQUIRE(config.is_initialized());
+  REQUIRE(&config.get().unwrap() == &config.get().unwrap());
+}
+
+TEST_CASE("lazy_result failure policies", "[lazy_result]"){
+  int calls = 0;
+  auto const flaky = [&]() -> result<int, std::string> {
+    if (++calls == 1) return failure("unavailable"s);
+    return success(calls);
+  };
+
+  lazy_result cached{flaky};
+  REQUIRE(cached.get() == failure("unavailable"s));
+  REQUIRE(cached.get() == failure("unavailable"s));
+  REQUIRE(calls == 1);
+
+  calls = 0;
+  lazy_result retried{flaky, lazy_policy::retry_failure};
+  REQUIRE(retried.get() == failure("unavailable"s));
+  REQUIRE_FALSE(retried.is_initialized());
+  REQUIRE(retried.get() == success(2));
+  REQUIRE(retried.get() == success(2));
+  REQUIRE(calls == 2);
+}
+
+TEST_CASE("lazy_result shares a failure with the waiting threads", "[lazy_result]"){
+  constexpr int n = 8;
+  std::atomic<int> calls{0};
+  std::atomic<int> arrived{0};
+  lazy_result<int, std::string> value{[&]() -> result<int, std::string> {
+    if (++calls > 1) return success(42);
+    // let every other thread block on the running initialization
+    while (arrived < n) std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    return failure("unavailable"s);
+  }, lazy_policy::retry_failure};
+
+  std::vector<std::thread> threads;
+  std::atomic<int> failed{0};
+  for (int i = 0; i < n; ++i) {
+    threads.emplace_back([&]{
+      ++arrived;
+      if (value.get() == failure("unavailable"s)) ++failed;
+    });
+  }
+  for (auto& t: threads) t.join();
+
+  REQUIRE(calls == 1);
+  REQUIRE(failed == n);
+  REQUIRE_FALSE(value.is_initialized());
+
+  // a later access retries
+  REQUIRE(value.get() == success(42));
+  REQUIRE(calls == 2);
+}
+
+TEST_CASE("lazy_result retries after an exception", "[lazy_result]"){
+  int calls = 0;
+  lazy_result<int, std::string> value{[&]() -> result<int, std::string> {
+    if (++calls == 1) throw std::runtime_error("boom");
+    return success(42);
+  }};
+  REQUIRE_THROWS_AS(value.get(), std::runtime_error);
+  REQUIRE(value.get() == success(42));
+  REQUIRE(calls == 2);
+}
+
+TEST_CASE("lazy_result vs mutex-guarded optional", "[lazy_result][!benchmark]"){
+  // warm accesses to the singletons of a service
+  constexpr int n = 200;
+  struct guarded {
+    std::mutex mutex;
+    std::optional<result<int, int>> value;
+  };
+  std::vector<std::unique_ptr<guarded>> optionals;
+  std::vector<std::unique_ptr<lazy_result<int, int>>> lazies;
+  for (int i = 0; i < n; ++i) {
+    optionals.push_back(std::make_unique<guarded>());
+    lazies.push_back(std::make_unique<lazy_result<int, int>>([i]() -> result<int, int> { return success(i); }));
+  }
+
+  BENCHMARK("std::mutex + std::optional") {
+    long sum = 0;
+    for (int i = 0; i < n; ++i) {
+      auto& g = *optionals[i];
+      std::lock_guard lock{g.mutex};
+      if (!g.value) g.value.emplace(success(i));
+      sum += g.value->unwrap_or(0);
+    }
+    return sum;
+  };
+
+  BENCHMARK("lazy_result") {
+    long sum = 0;
+    for (auto& lazy: lazies) sum += lazy->get().unwrap_or(0);
+    return sum;
+  };
+}
+
+TEST_CASE("memoize caches successes and failures", "[memoize]"){
+  std::atomic<int> calls{0};
+  memoize<int, int, std::string> square{[&](int x) -> result<int, std::string> {
+    ++calls;
+    if (x < 0) return failure("negative"s);
+    return success(x * x);
+  }, 64, std::chrono::hours(1)};
+
+  REQUIRE(square(3) == success(9));
+  REQUIRE(square(3) == success(9));
+  REQUIRE(square(-1) == failure("negative"s));
+  REQUIRE(square(-1) == failure("negative"s));
+  REQUIRE(calls == 2);
+
+  auto const stats = square.stats();
+  REQUIRE(stats.hits == 1);
+  REQUIRE(stats.negative_hits == 1);
+  REQUIRE(stats.misses == 2);
+  REQUIRE(stats.errors == 1);
+  REQUIRE(square.size() == 1);
+
+  square.invalidate(3);
+  square.invalidate(-1);
+  REQUIRE(square(3) == success(9));
+  REQUIRE(square(-1) == failure("negative"s));
+  REQUIRE(calls == 4);
+}
+
+TEST_CASE("memoize expires failures", "[memoize]"){
+  int calls = 0;
+  memoize<int, int, int> flaky{[&](int) -> result<int, int> {
+    if (++calls == 1) return failure(503);
+    return success(calls);
+  }, 64, std::chrono::milliseconds(20)};
+
+  REQUIRE(flaky(0) == failure(503));
+  REQUIRE(flaky(0) == failure(503));
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  REQUIRE(flaky(0) == success(2));
+  REQUIRE(flaky(0) == success(2));
+  REQUIRE(calls == 2);
+
+  // a non-positive TTL disables negative caching
+  calls = 0;
+  memoize<int, int, int> uncached{[&](int) -> result<int, int> { ++calls; return failure(503); }, 64, {}};
+  REQUIRE(uncached(0) == failure(503));
+  REQUIRE(uncached(0) == failure(503));
+  REQUIRE(calls == 2);
+}
+
+TEST_CASE("memoize evicts with a second chance", "[memoize]"){
+  memoize<int, int, int> id{[](int x) -> result<int, int> { return success(x); }, 4, {}, 1};
+  for (int i = 0; i < 4; ++i) REQUIRE(id(i) == success(i));
+  REQUIRE(id.size() == 4);
+  // 0 and 1 are referenced again, so 2 and 3 are evicted first
+  REQUIRE(id(0) == success(0));
+  REQUIRE(id(1) == success(1));
+  REQUIRE(id(4) == success(4));
+  REQUIRE(id(5) == success(5));
+  REQUIRE(id.size() == 4);
+  REQUIRE(id.stats().evictions == 2);
+
+  auto const misses = id.stats().misses;
+  REQUIRE(id(0) == success(0));
+  REQUIRE(id(1) == success(1));
+  REQUIRE(id.stats().misses == misses);
+  REQUIRE(id(2) == success(2));
+  REQUIRE(id.stats().misses == misses + 1);
+}
+
+TEST_CASE("memoize runs one computation per key at a time", "[memoize]"){
+  std::atomic<int> calls{0};
+  memoize<int, std::string, int> slow{[&](int x) -> result<std::string, int> {
+    ++calls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return success(std::to_string(x));
+  }, 64, {}};
+
+  std::vector<std::thread> threads;
+  std::atomic<int> ok{0};
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&]{
+      if (slow(42) == success("42"s)) ++ok;
+    });
+  }
+  for (auto& t: threads) t.join();
+
+  REQUIRE(ok == 8);
+  REQUIRE(calls == 1);
+  auto const stats = slow.stats();
+  REQUIRE(stats.misses == 1);
+  REQUIRE(stats.coalesced + stats.hits == 7);
+}
+
+TEST_CASE("memoize propagates exceptions without caching", "[memoize]"){
+  int calls = 0;
+  memoize<int, int, int> throwing{[&](int x) -> result<int, int> {
+    if (++calls == 1) throw std::runtime_error("boom");
+    return success(x);
+  }, 64, std::chrono::hours(1)};
+  REQUIRE_THROWS_AS(throwing(1), std::runtime_error);
+  REQUIRE(throwing(1) == success(1));
+  REQUIRE(calls == 2);
+}
+
+namespace {
+  bool copy_throws = false;
+
+  struct fragile {
+    int value;
+    explicit fragile(int v): value(v) {}
+    fragile(fragile&&) = default;
+    fragile& operator=(fragile&&) = default;
+    fragile(fragile const& other): value(other.value) { if (copy_throws) throw std::bad_alloc{}; }
+    fragile& operator=(fragile const& other) {
+      if (copy_throws) throw std::bad_alloc{};
+      value = other.value;
+      return *this;
+    }
+  };
+}
+
+TEST_CASE("memoize does not leave a key in flight when caching throws", "[memoize]"){
+  int calls = 0;
+  memoize<int, fragile, int> cache{[&](int x) -> result<fragile, int> {
+    ++calls;
+    return success(fragile{x});
+  }, 64, std::chrono::hours(1)};
+  copy_throws = true;
+  REQUIRE_THROWS_AS(cache(1), std::bad_alloc);
+  copy_throws = false;
+  REQUIRE(cache(1).unwrap().value == 1);
+  REQUIRE(calls == 2);
+  REQUIRE(cache(1).unwrap().value == 1);
+  REQUIRE(calls == 2);
+}
+
+TEST_CASE("memoize vs mutex-guarded std::map", "[memoize][!benchmark]"){
+  constexpr int n = 1024;
+  auto const lookup = [](int x) -> result<int, int> { return success(x * 2); };
+
+  std::mutex mutex;
+  std::map<int, result<int, int>> guarded;
+  memoize<int, int, int> cache{lookup, 2 * n, std::chrono::seconds(1)};
+  for (int i = 0; i < n; ++i) {
+    guarded.emplace(i, lookup(i));
+    (void)cache(i);
+  }
+
+  BENCHMARK("std::mutex + std::map, 4 threads") {
+    std::vector<std::thread> threads;
+    std::atomic<long> sum{0};
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&]{
+        long local = 0;
+        for (int i = 0; i < 20000; ++i) {
+          std::lock_guard lock{mutex};
+          local += guarded.at(i % n).unwrap_or(0);
+        }
+        sum += local;
+      });
+    }
+    for (auto& t: threads) t.join();
+    return sum.load();
+  };
+
+  BENCHMARK("memoize, 4 threads") {
+    std::vector<std::thread> threads;
+    std::atomic<long> sum{0};
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&]{
+        long local = 0;
+        for (int i = 0; i < 20000; ++i) local += cache(i % n).unwrap_or(0);
+        sum += local;
+      });
+    }
+    for (auto& t: threads) t.join();
+    return sum.load();
+  };
+}
+
+TEST_CASE("first_ok returns the first success", "[hedge]"){
+  auto const after = [](int ms, result<int, std::string> res) {
+    return [ms, res] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+      return res;
+    };
+  };
+
+  auto fastest = first_ok(after(50, success(1)), after(1, success(2)), after(20, failure("down"s)));
+  static_assert(std::is_same_v<decltype(fastest), result<int, std::tuple<std::string, std::string, std::string>>>);
+  REQUIRE(fastest == success(2));
+
+  // a failure does not end the race
+  REQUIRE(first_ok(after(1, failure("down"s)), after(10, success(3))) == success(3));
+
+  REQUIRE(first_ok(after(5, failure("a"s)), after(1, failure("b"s)))
+          == failure(std::tuple("a"s, "b"s)));
+}
+
+TEST_CASE("first_ok cancels the losers", "[hedge]"){
+  auto const cancelled = std::make_shared<std::atomic<bool>>(false);
+  auto const done = std::make_shared<std::atomic<bool>>(false);
+  auto res = first_ok(
+    [cancelled, done](cancel_token const& token) -> result<int, int> {
+      while (!token.is_cancelled()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      *cancelled = true;
+      *done = true;
+      return failure(0);
+    },
+    []() -> result<int, int> { return success(1); });
+  REQUIRE(res == success(1));
+  while (!*done) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  REQUIRE(*cancelled);
+}
+
+TEST_CASE("hedge starts the backup after the delay", "[hedge]"){
+  using namespace std::chrono;
+  auto const backups = std::make_shared<std::atomic<int>>(0);
+  auto const backup = [backups]() -> result<std::string, int> {
+    ++*backups;
+    return success("backup"s);
+  };
+
+  // the primary answers within the delay: no backup
+  auto fast = hedge([]() -> result<std::string, int> { return success("primary"s); }, backup, milliseconds(200));
+  REQUIRE(fast == success("primary"s));
+  REQUIRE(*backups == 0);
+
+  // the primary is slow: the backup wins
+  auto slow = hedge([]() -> result<std::string, int> {
+    std::this_thread::sleep_for(milliseconds(200));
+    return success("primary"s);
+  }, backup, milliseconds(5));
+  REQUIRE(slow == success("backup"s));
+  REQUIRE(*backups == 1);
+
+  // the primary fails: the backup starts without waiting for the delay
+  auto const start = steady_clock::now();
+  auto failed = hedge([]() -> result<std::string, int> { return failure(500); }, backup, seconds(10));
+  REQUIRE(failed == success("backup"s));
+  REQUIRE(steady_clock::now() - start < seconds(5));
+  REQUIRE(*backups == 2);
+
+  auto both = hedge([]() -> result<int, int> { return failure(1); }, []() -> result<int, int> { return failure(2); }, milliseconds(1));
+  REQUIRE(both == failure(std::tuple(1, 2)));
+}
+
+TEST_CASE("hedge rethrows when nothing succeeds", "[hedge]"){
+  auto const throwing = []() -> result<int, int> { throw std::runtime_error("boom"); };
+  REQUIRE_THROWS_AS(hedge(throwing, []() -> result<int, int> { return failure(2); }, std::chrono::milliseconds(1)), std::runtime_error);
+  REQUIRE(hedge(throwing, []() -> result<int, int> { return success(2); }, std::chrono::milliseconds(1)) == success(2));
+}
+
+TEST_CASE("hedge cuts the tail latency of a slow replica", "[hedge][!benchmark]"){
+  // every fourth call of the replica is slow
+  auto const calls = std::make_shared<std::atomic<int>>(0);
+  auto const replica = [calls]() -> result<int, int> {
+    std::this_thread::sleep_for(std::chrono::milliseconds(++*calls % 4 == 0 ? 40 : 1));
+    return success(1);
+  };
+
+  BENCHMARK("replica") { return replica(); };
+  BENCHMARK("hedge(replica, replica, 3ms)") { return hedge(replica, replica, std::chrono::milliseconds(3)); };
+}
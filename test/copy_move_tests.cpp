@@ -0,0 +1,194 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include <mitama/result/result.hpp>
+#include <mitama/maybe/maybe.hpp>
+
+#include <ostream>
+#include <utility>
+
+// An instrumented payload which counts its special member calls.
+// Each test pins the exact budget of an operation for a given value category,
+// so an accidental copy of a large payload fails loudly.
+struct budget {
+  int copies = 0;
+  int moves = 0;
+  int copy_assignments = 0;
+  int move_assignments = 0;
+
+  friend bool operator==(budget const& lhs, budget const& rhs) {
+    return lhs.copies == rhs.copies
+        && lhs.moves == rhs.moves
+        && lhs.copy_assignments == rhs.copy_assignments
+        && lhs.move_assignments == rhs.move_assignments;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, budget const& b) {
+    return os << "{copies: " << b.copies << ", moves: " << b.moves
+              << ", copy_assignments: " << b.copy_assignments
+              << ", move_assignments: " << b.move_assignments << "}";
+  }
+};
+
+struct payload {
+  static inline budget spent{};
+
+  int value;
+
+  payload(int value) : value(value) {}
+  payload(payload const& other) : value(other.value) { ++spent.copies; }
+  payload(payload&& other) noexcept : value(other.value) { ++spent.moves; }
+  payload& operator=(payload const& other) { value = other.value; ++spent.copy_assignments; return *this; }
+  payload& operator=(payload&& other) noexcept { value = other.value; ++spent.move_assignments; return *this; }
+  ~payload() = default;
+
+  friend bool operator==(payload const& lhs, payload const& rhs) { return lhs.value == rhs.value; }
+  friend bool operator<(payload const& lhs, payload const& rhs) { return lhs.value < rhs.value; }
+  friend std::ostream& operator<<(std::ostream& os, payload const& p) { return os << p.value; }
+};
+
+template <class F>
+budget spent_in(F&& f) {
+  payload::spent = budget{};
+  static_cast<void>(std::forward<F>(f)());
+  return payload::spent;
+}
+
+constexpr budget none{};
+constexpr budget copied(int n) { return budget{n, 0, 0, 0}; }
+constexpr budget moved(int n) { return budget{0, n, 0, 0}; }
+
+using namespace mitama;
+using res = mut_result<payload, payload>;
+
+namespace {
+  constexpr auto peek = [](payload const& p) { return p.value; };
+  constexpr auto peek_ok = [](payload const& p) -> mut_result<int, payload> { return success(p.value); };
+  constexpr auto peek_err = [](payload const& p) -> mut_result<payload, int> { return failure(p.value); };
+}
+
+TEST_CASE("basic_result construction budget", "[copy_move][result]"){
+  payload p = 1;
+  res r = success(1);
+
+  CHECK(spent_in([&]{ return res{success(p)}; }) == copied(1));
+  CHECK(spent_in([&]{ return res{in_place_ok, p}; }) == copied(1));
+  CHECK(spent_in([&]{ return res{in_place_ok, 1}; }) == none);
+  CHECK(spent_in([&]{ return res{r}; }) == copied(1));
+  CHECK(spent_in([&]{ return res{std::move(r)}; }) == moved(1));
+}
+
+TEST_CASE("basic_result observers budget", "[copy_move][result]"){
+  res ok = success(1);
+  res err = failure(2);
+
+  CHECK(spent_in([&]{ return ok.is_ok(); }) == none);
+  CHECK(spent_in([&]{ return ok.as_ref(); }) == none);
+  CHECK(spent_in([&]{ return ok.as_mut(); }) == none);
+  CHECK(spent_in([&]{ return &ok.unwrap(); }) == none);
+  CHECK(spent_in([&]{ return &err.unwrap_err(); }) == none);
+  CHECK(spent_in([&]{ return ok == err; }) == none);
+  CHECK(spent_in([&]{ return ok < err; }) == none);
+}
+
+TEST_CASE("basic_result lvalue combinators budget", "[copy_move][result]"){
+  res ok = success(1);
+  res err = failure(2);
+
+  CHECK(spent_in([&]{ return ok.ok(); }) == copied(1));
+  CHECK(spent_in([&]{ return err.err(); }) == copied(1));
+  CHECK(spent_in([&]{ return ok.map(peek); }) == none);
+  CHECK(spent_in([&]{ return err.map(peek); }) == copied(1));
+  CHECK(spent_in([&]{ return err.map_err(peek); }) == none);
+  CHECK(spent_in([&]{ return ok.map_err(peek); }) == copied(1));
+  CHECK(spent_in([&]{ return ok.and_then(peek_ok); }) == none);
+  CHECK(spent_in([&]{ return err.and_then(peek_ok); }) == copied(1));
+  CHECK(spent_in([&]{ return err.or_else(peek_err); }) == none);
+  CHECK(spent_in([&]{ return ok.or_else(peek_err); }) == copied(1));
+  CHECK(spent_in([&]{ return ok.conj(err); }) == copied(1));
+  CHECK(spent_in([&]{ return err.disj(ok); }) == copied(1));
+  CHECK(spent_in([&]{ return err.unwrap_or(payload{3}); }) == moved(1));
+  CHECK(spent_in([&]{ return ok.unwrap_or_else([](payload const&){ return payload{3}; }); }) == copied(1));
+  CHECK(spent_in([&]{ ok.and_finally(peek); }) == none);
+  CHECK(spent_in([&]{ err.or_finally(peek); }) == none);
+}
+
+TEST_CASE("basic_result rvalue combinators budget", "[copy_move][result]"){
+  res ok = success(1);
+  res err = failure(2);
+
+  CHECK(spent_in([&]{ return res{ok}.ok(); }) == budget{1, 1, 0, 0});
+  CHECK(spent_in([&]{ return std::move(ok).ok(); }) == moved(1));
+  CHECK(spent_in([&]{ return std::move(err).err(); }) == moved(1));
+  CHECK(spent_in([&]{ return std::move(ok).map(peek); }) == none);
+  CHECK(spent_in([&]{ return std::move(err).map(peek); }) == moved(2));
+  CHECK(spent_in([&]{ return std::move(err).map_err(peek); }) == none);
+  CHECK(spent_in([&]{ return std::move(ok).map_err(peek); }) == moved(2));
+  CHECK(spent_in([&]{ return std::move(ok).and_then(peek_ok); }) == none);
+  CHECK(spent_in([&]{ return std::move(err).and_then(peek_ok); }) == moved(2));
+  CHECK(spent_in([&]{ return std::move(err).or_else(peek_err); }) == none);
+  CHECK(spent_in([&]{ return std::move(ok).or_else(peek_err); }) == moved(2));
+  CHECK(spent_in([&]{ return std::move(ok).conj(std::move(err)); }) == moved(2));
+  CHECK(spent_in([&]{ return std::move(err).conj(std::move(ok)); }) == moved(2));
+  CHECK(spent_in([&]{ return std::move(err).disj(std::move(ok)); }) == moved(2));
+  CHECK(spent_in([&]{ return std::move(ok) && std::move(ok); }) == moved(2));
+  CHECK(spent_in([&]{ return std::move(err) || std::move(err); }) == moved(2));
+  CHECK(spent_in([&]{ return std::move(ok).unwrap_or(payload{3}); }) == moved(1));
+  CHECK(spent_in([&]{ return std::move(ok).unwrap_or_else([](payload&&){ return payload{3}; }); }) == moved(1));
+  CHECK(spent_in([&]{ return std::move(err).unwrap_or_else([](payload&& e){ return std::move(e); }); }) == moved(1));
+  CHECK(spent_in([&]{ std::move(ok).and_finally([](payload&&){}); }) == none);
+  CHECK(spent_in([&]{ std::move(err).or_finally([](payload&&){}); }) == none);
+}
+
+TEST_CASE("maybe construction budget", "[copy_move][maybe]"){
+  payload p = 1;
+  maybe<payload> m = just(1);
+
+  CHECK(spent_in([&]{ return maybe<payload>{just(p)}; }) == copied(1));
+  CHECK(spent_in([&]{ return maybe<payload>{std::in_place, p}; }) == copied(1));
+  CHECK(spent_in([&]{ return maybe<payload>{std::in_place, 1}; }) == none);
+  CHECK(spent_in([&]{ return maybe<payload>{m}; }) == copied(1));
+  CHECK(spent_in([&]{ return maybe<payload>{std::move(m)}; }) == moved(1));
+}
+
+TEST_CASE("maybe lvalue combinators budget", "[copy_move][maybe]"){
+  maybe<payload> some = just(1);
+  maybe<payload> empty = nothing;
+
+  CHECK(spent_in([&]{ return &some.unwrap(); }) == none);
+  CHECK(spent_in([&]{ return some.as_ref(); }) == none);
+  CHECK(spent_in([&]{ return some.map(peek); }) == none);
+  CHECK(spent_in([&]{ return some.and_then([](payload const& p) -> maybe<int> { return just(p.value); }); }) == none);
+  CHECK(spent_in([&]{ return some.filter([](payload const&){ return true; }); }) == copied(1));
+  CHECK(spent_in([&]{ return some.or_else([]{ return maybe<payload>{}; }); }) == copied(1));
+  CHECK(spent_in([&]{ return some.ok_or(); }) == copied(1));
+  CHECK(spent_in([&]{ return empty.unwrap_or(payload{2}); }) == moved(1));
+  CHECK(spent_in([&]{ return some == empty; }) == none);
+}
+
+TEST_CASE("maybe rvalue combinators budget", "[copy_move][maybe]"){
+  maybe<payload> some = just(1);
+
+  CHECK(spent_in([&]{ return std::move(some).unwrap(); }) == moved(1));
+  CHECK(spent_in([&]{ return std::move(some).map(peek); }) == none);
+  CHECK(spent_in([&]{ return std::move(some).filter([](payload const&){ return true; }); }) == moved(1));
+  CHECK(spent_in([&]{ return std::move(some).or_else([]{ return maybe<payload>{}; }); }) == moved(1));
+  CHECK(spent_in([&]{ return std::move(some).ok_or(); }) == moved(1));
+  CHECK(spent_in([&]{ return std::move(some).unwrap_or(payload{2}); }) == moved(1));
+}
+
+TEST_CASE("maybe mutators budget", "[copy_move][maybe]"){
+  maybe<payload> slot = nothing;
+
+  CHECK(spent_in([&]{ return &slot.get_or_emplace(1); }) == none);
+  CHECK(spent_in([&]{ return &slot.insert(2); }) == none);
+  CHECK(spent_in([&]{ return slot.replace(3); }) == moved(1));
+  CHECK(spent_in([&]{ return slot.replace_with([]{ return payload{4}; }); }) == moved(2));
+  CHECK(spent_in([&]{ return slot.take(); }) == moved(1));
+  CHECK(spent_in([&]{ return slot.take_if([](payload&){ return true; }); }) == none);
+
+  maybe<maybe<payload>> nested = just(just(5));
+  CHECK(spent_in([&]{ return nested.flatten(); }) == copied(1));
+  CHECK(spent_in([&]{ return std::move(nested).flatten(); }) == moved(1));
+}
@@ -0,0 +1,162 @@
+#define CATCH_CONFIG_MAIN
+#define MITAMA_ERROR_RETURN_TRACE
+#define MITAMA_ERROR_RETURN_TRACE_DEPTH 4
+
+#include <catch2/catch.hpp>
+
+#include <mitama/result/result.hpp>
+#include <mitama/maybe/maybe.hpp>
+#include <mitama/result/error_return_trace.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace mitama;
+using namespace std::literals;
+
+namespace {
+  std::uint_least32_t origin_line = 0;
+  std::uint_least32_t inner_line = 0;
+  std::uint_least32_t outer_line = 0;
+
+  result<int, std::string> load(bool ok) {
+    if (!ok) {
+      origin_line = __LINE__ + 1;
+      return failure("not found"s);
+    }
+    return success(42);
+  }
+
+  result<int, std::string> parse(bool ok) {
+    inner_line = __LINE__ + 1;
+    int v = MITAMA_TRY(load(ok));
+    return success(v + 1);
+  }
+
+  result<int, std::string> run(bool ok) {
+    outer_line = __LINE__ + 1;
+    int v = MITAMA_TRY(parse(ok));
+    return success(v * 2);
+  }
+
+  std::uint_least32_t relay_line = 0;
+  std::uint_least32_t relay_missing_line = 0;
+
+  result<int, int> old_handled() {
+    return failure(-1);
+  }
+
+  result<int, int> unrelated() {
+    return result<int, int>{in_place_err, 42};
+  }
+
+  result<int, int> relay() {
+    relay_line = __LINE__ + 1;
+    return success(MITAMA_TRY(unrelated()));
+  }
+
+  result<int, int> relay_missing(maybe<int> m) {
+    relay_missing_line = __LINE__ + 1;
+    return success(MITAMA_TRY(m.ok_or(42)));
+  }
+
+  result<int, std::string> recurse(int n) {
+    if (n == 0) return failure("bottom"s);
+    return success(MITAMA_TRY(recurse(n - 1)));
+  }
+}
+
+TEST_CASE("MITAMA_TRY records the propagation path", "[error_return_trace]"){
+  error_return_trace::clear();
+  REQUIRE(run(false).is_err());
+
+  auto trace = error_return_trace::current();
+  REQUIRE(trace.has_origin);
+  REQUIRE(trace.origin.line == origin_line);
+  REQUIRE(trace.dropped == 0);
+  REQUIRE(trace.frames.size() == 2);
+  REQUIRE(trace.frames[0].line == inner_line);
+  REQUIRE(trace.frames[1].line == outer_line);
+  REQUIRE(trace.frames[0].file == std::string{__FILE__});
+}
+
+TEST_CASE("a new failure starts a new trace", "[error_return_trace]"){
+  (void)run(false);
+  (void)load(false);
+
+  auto trace = error_return_trace::current();
+  REQUIRE(trace.origin.line == origin_line);
+  REQUIRE(trace.frames.empty());
+}
+
+TEST_CASE("success does not touch the trace", "[error_return_trace]"){
+  (void)run(false);
+  REQUIRE(run(true).is_ok());
+  REQUIRE(error_return_trace::current().frames.size() == 2);
+}
+
+TEST_CASE("a recovered failure is not the origin of a later one", "[error_return_trace]"){
+  REQUIRE(old_handled().unwrap_or(0) == 0);
+  auto r = relay();
+
+  auto trace = error_return_trace::current();
+  REQUIRE(r.unwrap_err() == 42);
+  REQUIRE_FALSE(trace.has_origin);
+  REQUIRE(trace.frames.size() == 1);
+  REQUIRE(trace.frames[0].line == relay_line);
+}
+
+TEST_CASE("a failure made without failure() starts a new trace", "[error_return_trace]"){
+  // handled by hand: the trace of `old_handled` is still in progress
+  REQUIRE(old_handled().is_err());
+  auto r = relay_missing(nothing);
+
+  auto trace = error_return_trace::current();
+  REQUIRE(r.unwrap_err() == 42);
+  REQUIRE_FALSE(trace.has_origin);
+  REQUIRE(trace.frames.size() == 1);
+  REQUIRE(trace.frames[0].line == relay_missing_line);
+}
+
+TEST_CASE("the trace is readable while recovering", "[error_return_trace]"){
+  auto recovered = run(false).or_else([](auto const&) -> result<int, std::string> {
+    auto trace = error_return_trace::current();
+    REQUIRE(trace.origin.line == origin_line);
+    REQUIRE(trace.frames.size() == 2);
+    return success(0);
+  });
+  REQUIRE(recovered == success(0));
+
+  REQUIRE(relay().is_err());
+  REQUIRE_FALSE(error_return_trace::current().has_origin);
+}
+
+TEST_CASE("the ring buffer keeps the outermost frames", "[error_return_trace]"){
+  REQUIRE(recurse(10).is_err());
+
+  auto trace = error_return_trace::current();
+  REQUIRE(trace.frames.size() == 4);
+  REQUIRE(trace.dropped == 6);
+}
+
+TEST_CASE("traces are per thread", "[error_return_trace]"){
+  (void)run(false);
+  std::thread([]{
+    REQUIRE_FALSE(error_return_trace::current().has_origin);
+  }).join();
+  REQUIRE(error_return_trace::current().frames.size() == 2);
+}
+
+TEST_CASE("error return trace is printable", "[error_return_trace]"){
+  (void)run(false);
+
+  std::ostringstream ss;
+  ss << error_return_trace::current();
+  auto str = ss.str();
+  REQUIRE(str.find("error return trace:\n") == 0);
+  REQUIRE(str.find("failure at "s + __FILE__ + ":" + std::to_string(origin_line)) != std::string::npos);
+  REQUIRE(str.find("propagated at "s + __FILE__ + ":" + std::to_string(inner_line)) != std::string::npos);
+  REQUIRE(str.find("propagated at "s + __FILE__ + ":" + std::to_string(outer_line)) != std::string::npos);
+}
@@ -0,0 +1,94 @@
+#define CATCH_CONFIG_MAIN
+#define MITAMA_FAILURE_STATISTICS
+
+#include <catch2/catch.hpp>
+
+#include <mitama/result/result.hpp>
+#include <mitama/result/failure_statistics.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mitama;
+using namespace std::literals;
+
+namespace {
+  std::uint_least32_t parse_line = 0;
+
+  result<int, std::string> parse(std::string_view str) {
+    if (str.empty()) {
+      parse_line = __LINE__ + 1;
+      return failure("empty"s);
+    }
+    return success(static_cast<int>(str.size()));
+  }
+
+  std::uint_least32_t unit_line = 0;
+
+  result<int> check(bool ok) {
+    unit_line = __LINE__ + 1;
+    return ok ? result<int>{success(1)} : result<int>{failure()};
+  }
+
+  std::uint64_t count_at(failure_statistics::snapshot_t const& snap, std::uint_least32_t line) {
+    auto found = std::find_if(snap.entries.begin(), snap.entries.end(),
+                              [line](auto const& e) { return e.line == line && e.file == __FILE__; });
+    return found == snap.entries.end() ? 0 : found->count;
+  }
+}
+
+TEST_CASE("failure() records its call site", "[failure_statistics]"){
+  failure_statistics::reset();
+
+  for (int i = 0; i < 3; ++i) (void)parse("");
+  (void)parse("ok");
+  (void)check(false);
+  (void)check(true);
+
+  auto snap = failure_statistics::snapshot();
+  REQUIRE(count_at(snap, parse_line) == 3);
+  REQUIRE(count_at(snap, unit_line) == 1);
+  REQUIRE(snap.dropped == 0);
+  // sorted by descending count
+  REQUIRE(snap.entries.front().line == parse_line);
+}
+
+TEST_CASE("failure statistics are aggregated over threads", "[failure_statistics]"){
+  failure_statistics::reset();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([]{ for (int i = 0; i < 100; ++i) (void)parse(""); });
+  for (auto& th: threads) th.join();
+  (void)parse("");
+
+  auto snap = failure_statistics::snapshot();
+  REQUIRE(count_at(snap, parse_line) == 401);
+}
+
+TEST_CASE("failure statistics reset", "[failure_statistics]"){
+  (void)parse("");
+  failure_statistics::reset();
+  REQUIRE(count_at(failure_statistics::snapshot(), parse_line) == 0);
+}
+
+TEST_CASE("failure statistics dump", "[failure_statistics]"){
+  failure_statistics::reset();
+  (void)parse("");
+  (void)parse("");
+  auto snap = failure_statistics::snapshot();
+
+  std::ostringstream text;
+  failure_statistics::write_text(text, snap);
+  REQUIRE(text.str().find("2 "s + __FILE__ + ":" + std::to_string(parse_line)) != std::string::npos);
+
+  std::ostringstream json;
+  failure_statistics::write_json(json, snap);
+  REQUIRE(json.str().find("{\"dropped\":0,\"sites\":[{\"file\":") == 0);
+  REQUIRE(json.str().find("\"line\":"s + std::to_string(parse_line) + ",") != std::string::npos);
+  REQUIRE(json.str().find("\"count\":2}") != std::string::npos);
+}
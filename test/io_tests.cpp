@@ -0,0 +1,165 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch.hpp>
+
+#include <mitama/result/result.hpp>
+#include <mitama/io/io.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace mitama;
+using namespace std::literals;
+
+namespace {
+  /// a temporary file, removed on destruction
+  struct temp_path {
+    std::string path;
+    temp_path() {
+      char name[] = "/tmp/mitama_io_XXXXXX";
+      ::close(::mkstemp(name));
+      path = name;
+    }
+    ~temp_path() { ::unlink(path.c_str()); }
+  };
+
+  std::string_view as_chars(std::vector<std::byte> const& bytes) {
+    return {reinterpret_cast<char const*>(bytes.data()), bytes.size()};
+  }
+}
+
+TEST_CASE("open_file failure", "[io]"){
+  REQUIRE(io::open_file("/nonexistent/mitama") == failure(io::io_error{ENOENT, io::io_operation::open}));
+  REQUIRE(io::read_all("/nonexistent/mitama").is_err());
+  REQUIRE(io::map_file("/nonexistent/mitama").is_err());
+  REQUIRE(io::file{}.close() == failure(io::io_error{EBADF, io::io_operation::close}));
+}
+
+TEST_CASE("write_all and read_all", "[io]"){
+  temp_path tmp;
+  {
+    auto res = io::open_file(tmp.path, O_WRONLY | O_TRUNC);
+    auto const& out = res.unwrap();
+    REQUIRE(io::write_all(out, "hello, "sv).is_ok());
+    REQUIRE(io::write_all(out, "world").is_ok());
+  }
+  auto contents = io::read_all(tmp.path);
+  REQUIRE(as_chars(contents.unwrap()) == "hello, world");
+}
+
+TEST_CASE("pread and pwrite", "[io]"){
+  temp_path tmp;
+  auto res = io::open_file(tmp.path, O_RDWR);
+  auto const& f = res.unwrap();
+  REQUIRE(io::pwrite(f, "0123456789", 10, 0).is_ok());
+  REQUIRE(io::pwrite(f, "ab", 2, 4).is_ok());
+
+  char buf[8] = {};
+  REQUIRE(io::pread(f, buf, 4, 3) == success(4u));
+  REQUIRE(std::string_view(buf, 4) == "3ab6");
+  // short only at end of file
+  REQUIRE(io::pread(f, buf, 8, 6) == success(4u));
+  REQUIRE(io::pread(f, buf, 8, 100) == success(0u));
+}
+
+TEST_CASE("map_file", "[io]"){
+  temp_path tmp;
+  {
+    std::ofstream out(tmp.path);
+    out << "mapped contents";
+  }
+  auto view = io::map_file(tmp.path);
+  REQUIRE(view.unwrap().str() == "mapped contents");
+  REQUIRE(view.unwrap().size() == 15);
+
+  // the view can be moved out of the result
+  auto const first_word = [](std::string const& path) -> result<std::string, io::io_error> {
+    io::mapped_view mapped = MITAMA_TRY(io::map_file(path));
+    return success(std::string(mapped.str().substr(0, mapped.str().find(' '))));
+  };
+  REQUIRE(first_word(tmp.path) == success("mapped"s));
+
+  temp_path empty;
+  REQUIRE(io::map_file(empty.path).unwrap().empty());
+}
+
+TEST_CASE("map_file rejects files without a known size", "[io]"){
+  int fds[2];
+  REQUIRE(::pipe(fds) == 0);
+  io::file read_end{fds[0]};
+  io::file write_end{fds[1]};
+  REQUIRE(io::write_all(write_end, "piped"sv).is_ok());
+  REQUIRE(io::map_file(read_end) == failure(io::io_error{ENODEV, io::io_operation::map}));
+
+#if defined(__linux__)
+  // procfs reports a size of zero for files that are not empty
+  REQUIRE(io::map_file("/proc/self/status") == failure(io::io_error{ENODEV, io::io_operation::map}));
+  REQUIRE_FALSE(io::read_all("/proc/self/status").unwrap().empty());
+#endif
+}
+
+TEST_CASE("partial writes to a pipe are continued", "[io]"){
+  int fds[2];
+  REQUIRE(::pipe(fds) == 0);
+  io::file read_end{fds[0]};
+  io::file write_end{fds[1]};
+
+  // much larger than the pipe buffer: write(2) returns early while the reader catches up
+  std::string const data(1 << 22, 'x');
+  bool written = false;
+  bool closed = false;
+  std::thread writer([&]{
+    written = io::write_all(write_end, data).is_ok();
+    closed = write_end.close().is_ok();
+  });
+  auto received = io::read_all(read_end);
+  writer.join();
+  REQUIRE(written);
+  REQUIRE(closed);
+  REQUIRE(received.unwrap().size() == data.size());
+}
+
+TEST_CASE("io_error is printable", "[io]"){
+  std::ostringstream ss;
+  ss << io::io_error{ENOENT, io::io_operation::open};
+  REQUIRE(ss.str() == "open: No such file or directory");
+}
+
+TEST_CASE("read_all and map_file vs std::ifstream", "[io][!benchmark]"){
+  temp_path tmp;
+  {
+    auto res = io::open_file(tmp.path, O_WRONLY | O_TRUNC);
+    std::string chunk(1 << 20, 'a');
+    for (int i = 0; i < 16; ++i) REQUIRE(io::write_all(res.unwrap(), chunk).is_ok());
+  }
+
+  BENCHMARK("std::ifstream") {
+    std::ifstream in(tmp.path, std::ios::binary);
+    std::string contents{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    return std::count(contents.begin(), contents.end(), 'a');
+  };
+
+  BENCHMARK("read_all") {
+    auto contents = io::read_all(tmp.path);
+    auto const& bytes = contents.unwrap();
+    return std::count(bytes.begin(), bytes.end(), std::byte{'a'});
+  };
+
+  BENCHMARK("map_file") {
+    auto view = io::map_file(tmp.path);
+    auto const& bytes = view.unwrap();
+    return std::count(bytes.begin(), bytes.end(), std::byte{'a'});
+  };
+}
@@ -1,4 +1,5 @@
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch.hpp>
 #include <mitama/result/result.hpp>
 #include <mitama/result/result_io.hpp>
@@ -7,7 +8,16 @@
 
 #include <boost/xpressive/xpressive.hpp>
 
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <sstream>
 #include <string>
+#include <vector>
+#include <memory>
+#include <utility>
 
 using namespace mitama;
 using namespace std::string_literals;
@@ -365,6 +375,58 @@ TEST_CASE("replace()", "[maybe][replace]"){
   }
 }
 
+TEST_CASE("replace() with move-only type", "[maybe][replace]"){
+  maybe<std::unique_ptr<int>> x = just(std::make_unique<int>(1));
+  auto old = x.replace(std::make_unique<int>(2));
+  REQUIRE(*old.unwrap() == 1);
+  REQUIRE(*x.unwrap() == 2);
+  auto old2 = x.replace_with([]{ return std::make_unique<int>(3); });
+  REQUIRE(*old2.unwrap() == 2);
+  REQUIRE(*x.unwrap() == 3);
+}
+
+TEST_CASE("take()", "[maybe][take]"){
+  {
+    maybe x = just("foo"s);
+    auto y = x.take();
+    REQUIRE(x == nothing);
+    REQUIRE(y == just("foo"s));
+  }
+  {
+    maybe<std::string> x = nothing;
+    auto y = x.take();
+    REQUIRE(x == nothing);
+    REQUIRE(y == nothing);
+  }
+  {
+    int i = 42;
+    maybe<int&> x = just(i);
+    auto y = x.take();
+    REQUIRE(x == nothing);
+    REQUIRE(&y.unwrap() == &i);
+  }
+}
+
+TEST_CASE("take_if()", "[maybe][take_if]"){
+  maybe x = just(42);
+  auto none = x.take_if([](int& v){ return v == 43; });
+  REQUIRE(x == just(42));
+  REQUIRE(none == nothing);
+
+  auto prev = x.take_if([](int& v){ return v == 42; });
+  REQUIRE(x == nothing);
+  REQUIRE(prev == just(42));
+}
+
+TEST_CASE("insert()", "[maybe][insert]"){
+  maybe<std::vector<int>> x = nothing;
+  auto& v = x.insert(3u, 1);
+  REQUIRE(v == std::vector{1, 1, 1});
+  v.push_back(2);
+  REQUIRE(x.insert(std::vector{4, 5}) == std::vector{4, 5});
+  REQUIRE(x == just(std::vector{4, 5}));
+}
+
 TEST_CASE("transpose()", "[maybe][transpose]"){
 
   result<maybe<int>, std::string> x = success(just(5));
@@ -395,6 +457,17 @@ TEST_CASE("flatten()", "[maybe][flatten]"){
   maybe<maybe<maybe<int>>> nest = just(just(just(6)));
   REQUIRE(just(6) == nest.flatten().flatten());
 
+  // Flattening an rvalue moves the inner value out:
+  maybe<maybe<std::unique_ptr<int>>> owner = just(just(std::make_unique<int>(6)));
+  maybe<std::unique_ptr<int>> flat = std::move(owner).flatten();
+  REQUIRE(*flat.unwrap() == 6);
+
+}
+
+TEST_CASE("or_else() with move-only type", "[maybe][or_else]"){
+  maybe<std::unique_ptr<int>> x = maybe<std::unique_ptr<int>>{just(std::make_unique<int>(1))}
+    .or_else([]{ return maybe<std::unique_ptr<int>>{}; });
+  REQUIRE(*x.unwrap() == 1);
 }
 
 TEST_CASE("and_finally()", "[maybe][and_finally]"){
@@ -973,6 +1046,72 @@ TEST_CASE("forward mode test", "[maybe][forward]"){
   REQUIRE(vec == just(std::vector{1,2,3}));
 }
 
+namespace constexpr_test {
+  struct field { std::uint8_t width; maybe<std::uint8_t> offset; };
+
+  inline constexpr std::array<maybe<field>, 4> fields = {{
+    just(field{1, just(std::uint8_t{0})}),
+    nothing,
+    just(field{4, nothing}),
+    just(field{2, just(std::uint8_t{8})}),
+  }};
+
+  constexpr maybe<int> half(int x) { return x % 2 == 0 ? maybe<int>{x / 2} : nothing; }
+
+  inline constexpr int value = 42;
+}
+
+TEST_CASE("constexpr maybe test", "[maybe][constexpr]"){
+  using namespace constexpr_test;
+  constexpr maybe<int> x = just(2);
+  constexpr maybe<int> y = nothing;
+  static_assert(x.is_just() && y.is_nothing());
+  static_assert(static_cast<bool>(x) && !y);
+  static_assert(x.unwrap() == 2);
+  static_assert(x.expect("x") == 2);
+  static_assert(y.unwrap_or(3) == 3);
+  static_assert(y.unwrap_or_else([]{ return 4; }) == 4);
+  static_assert(x.map([](int v){ return v * 2; }) == just(4));
+  static_assert(x.map_or(0, [](int v){ return v + 1; }) == 3);
+  static_assert(y.map_or_else([]{ return 0; }, [](int v){ return v + 1; }) == 0);
+  static_assert(x.and_then(half) == just(1));
+  static_assert(maybe<int>{3}.and_then(half) == nothing);
+  static_assert(y.or_else([]{ return maybe<int>{5}; }) == just(5));
+  static_assert(x.filter([](int v){ return v > 1; }) == x);
+  static_assert((x && y) == nothing);
+  static_assert((y || x) == just(2));
+  static_assert((x ^ y) == just(2));
+  static_assert(x.ok_or().is_ok());
+  static_assert(y.unwrap_or_default() == 0);
+  static_assert(maybe<maybe<int>>{just(x)}.flatten() == just(2));
+  static_assert(maybe<int>{just(1)} < x && y < x && y <= y && x >= x && !(y > x));
+
+  constexpr maybe<int const&> ref = just(value);
+  static_assert(ref.unwrap() == 42);
+  static_assert(ref.cloned() == just(42));
+
+  constexpr maybe<std::pair<int, int>> pair = just<std::pair<int, int>>(1, 2);
+  static_assert(pair->second == 2);
+
+  static_assert(fields[0]->offset == just(0));
+  static_assert(fields[1] == nothing);
+  static_assert(fields[2]->offset.is_nothing());
+  static_assert(fields[3].map([](field const& f){ return f.width; }).unwrap_or(0) == 2);
+}
+
+#if defined(__cpp_lib_variant) && __cpp_lib_variant >= 202106L
+TEST_CASE("constexpr maybe mutation test", "[maybe][constexpr]"){
+  constexpr auto taken = []{
+    maybe<int> x = just(1);
+    auto old = x.take();
+    x.insert(2);
+    x.get_or_emplace(3) += 1;
+    return old.unwrap() * 10 + x.unwrap();
+  }();
+  static_assert(taken == 13);
+}
+#endif
+
 TEST_CASE("range_to_maybe test", "[maybe][range_to_maybe]"){
   std::vector v{1,2,3};
   maybe x = range_to_maybe(v);
@@ -986,6 +1125,157 @@ TEST_CASE("range_to_maybe test", "[maybe][range_to_maybe]"){
   REQUIRE(z == 1);
 }
 
+namespace {
+  // an input-only range
+  struct int_stream {
+    std::istream* is;
+    std::istream_iterator<int> begin() const { return std::istream_iterator<int>{*is}; }
+    std::istream_iterator<int> end() const { return {}; }
+  };
+
+  template <class T>
+  T* address_of(maybe<T&> m) { return m.is_just() ? &m.unwrap() : nullptr; }
+}
+
+TEST_CASE("range search test", "[maybe][range_to_maybe]"){
+  std::vector v{3, 1, 4, 1, 5};
+
+  // borrowed from lvalue ranges
+  maybe<int&> f = first(v);
+  REQUIRE(&f.unwrap() == &v[0]);
+  REQUIRE(address_of(last(v)) == &v[4]);
+  REQUIRE(address_of(nth(v, 2)) == &v[2]);
+  REQUIRE(nth(v, 5) == nothing);
+  REQUIRE(address_of(find_if(v, [](int x) { return x > 3; })) == &v[2]);
+  REQUIRE(find_if(v, [](int x) { return x > 5; }) == nothing);
+  REQUIRE(address_of(min_element(v)) == &v[1]);
+  REQUIRE(address_of(max_element(v)) == &v[4]);
+  REQUIRE(address_of(max_element(v, std::greater<>{})) == &v[1]);
+  f.unwrap() = 9;
+  REQUIRE(v[0] == 9);
+
+  std::vector<int> const& cv = v;
+  static_assert(std::is_same_v<decltype(first(cv)), maybe<int const&>>);
+
+  // dangling from rvalue ranges
+  static_assert(std::is_same_v<decltype(first(std::vector{1})), maybe<dangling<std::reference_wrapper<int>>>>);
+  REQUIRE(first(std::vector<int>{}) == nothing);
+
+  std::list l{2, 7, 1};
+  REQUIRE(address_of(last(l)) == &l.back());
+  REQUIRE(nth(l, 1) == just(7));
+
+  int a[] = {5, 6};
+  REQUIRE(address_of(last(a)) == &a[1]);
+
+  // by value from input ranges
+  std::istringstream in{"4 2 8 6"};
+  auto max = max_element(int_stream{&in});
+  static_assert(std::is_same_v<decltype(max), maybe<int>>);
+  REQUIRE(max == just(8));
+}
+
+#include <mitama/maybe/dictionary.hpp>
+#include <any>
+#include <boost/container/flat_map.hpp>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+  // a dictionary without `find`
+  struct assoc_list: std::vector<std::pair<std::string, int>> {
+    using key_type = std::string;
+    using mapped_type = int;
+    using std::vector<std::pair<std::string, int>>::vector;
+  };
+}
+
+TEMPLATE_TEST_CASE("dictionary lookup test", "[maybe][dictionary]",
+  (std::map<std::string, int, std::less<>>),
+  (std::unordered_map<std::string, int>),
+  (boost::container::flat_map<std::string, int, std::less<>>))
+{
+  TestType dict{{"one", 1}, {"two", 2}};
+
+  REQUIRE(get(dict, "one"s) == just(1));
+  REQUIRE(get(dict, "three"s) == nothing);
+  static_assert(std::is_same_v<decltype(get(dict, "one"s)), maybe<int const&>>);
+
+  maybe<int&> two = get_mut(dict, "two"s);
+  two.unwrap() = 20;
+  REQUIRE(dict["two"] == 20);
+
+  int calls = 0;
+  auto make = [&calls]{ ++calls; return 3; };
+  REQUIRE(get_or_insert_with(dict, "three"s, make) == just(3));
+  REQUIRE(get_or_insert_with(dict, "three"s, make) == just(3));
+  REQUIRE(calls == 1);
+  REQUIRE(dict.size() == 3);
+}
+
+TEMPLATE_TEST_CASE("get_or_insert_with stores the result of f", "[maybe][dictionary]",
+  (std::map<int, std::any>),
+  (std::unordered_map<int, std::any>))
+{
+  // std::any is constructible from anything: a lazily converted value would be stored as is
+  TestType dict;
+  int calls = 0;
+  auto make = [&calls]{ ++calls; return 3; };
+  REQUIRE(std::any_cast<int>(get_or_insert_with(dict, 1, make).unwrap()) == 3);
+  REQUIRE(std::any_cast<int>(get_or_insert_with(dict, 1, make).unwrap()) == 3);
+  REQUIRE(calls == 1);
+  REQUIRE(std::any_cast<int>(dict.at(1)) == 3);
+}
+
+TEST_CASE("unwrap of rvalue maybe<T&> test", "[maybe][unwrap]"){
+  std::string str = "referent";
+  static_assert(std::is_same_v<decltype(maybe<std::string&>{std::in_place, str}.unwrap()), std::string&>);
+  maybe<std::string&>{std::in_place, str}.unwrap() += "!";
+  REQUIRE(str == "referent!");
+}
+
+TEST_CASE("heterogeneous dictionary lookup test", "[maybe][dictionary]"){
+  std::map<std::string, int, std::less<>> dict{{"one", 1}};
+  std::string_view key = "one";
+  REQUIRE(get(dict, key) == just(1));
+  REQUIRE(get_mut(dict, "one") == just(1));
+}
+
+TEST_CASE("dictionary without find test", "[maybe][dictionary]"){
+  assoc_list dict{{"one", 1}};
+  REQUIRE(get(dict, "one"s) == just(1));
+  REQUIRE(get_mut(dict, "two"s) == nothing);
+}
+
+TEST_CASE("multi_get test", "[maybe][dictionary][multi_get]"){
+  std::unordered_map<int, std::string> dict;
+  for (int i = 0; i < 100; ++i) dict.emplace(i, std::to_string(i));
+
+  std::vector<int> keys;
+  for (int i = -10; i < 110; i += 3) keys.push_back(i);
+
+  auto found = multi_get(dict, keys);
+  static_assert(std::is_same_v<decltype(found), std::vector<maybe<std::string const&>>>);
+  REQUIRE(found.size() == keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    if (0 <= keys[i] && keys[i] < 100)
+      REQUIRE(&found[i].unwrap() == &dict.at(keys[i]));
+    else
+      REQUIRE(found[i] == nothing);
+  }
+
+  auto mutable_found = multi_get_mut(dict, std::vector{1, 2});
+  mutable_found[1].unwrap() = "two";
+  REQUIRE(dict[2] == "two");
+
+  REQUIRE(multi_get(std::unordered_map<int, int>{}, keys) == std::vector<maybe<int const&>>(keys.size()));
+  std::map<int, int> const ordered{{1, 1}};
+  auto from_ordered = multi_get(ordered, std::vector{1, 2});
+  REQUIRE(from_ordered[0] == just(1));
+  REQUIRE(from_ordered[1] == nothing);
+}
+
 #include <mitama/boolinators.hpp>
 
 TEST_CASE("as_maybe test", "[maybe][as_maybe][boolinators]"){
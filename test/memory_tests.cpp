@@ -0,0 +1,334 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include <mitama/result/result.hpp>
+#include <mitama/memory/fallible_allocator.hpp>
+#include <mitama/memory/fallible_container.hpp>
+#include <mitama/memory/arena.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Replaces the global allocation functions so that allocations can be made to fail.
+// `throwing_calls` counts the calls of the throwing `operator new` while failing,
+// which a fallible operation must not make.
+namespace {
+  bool failing = false;
+  std::size_t throwing_calls = 0;
+  std::size_t nothrow_calls = 0;
+
+  template <class F>
+  decltype(auto) out_of_memory(F&& f) {
+    failing = true;
+    throwing_calls = 0;
+    struct restore { ~restore() { failing = false; } } guard;
+    return std::forward<F>(f)();
+  }
+}
+
+void* operator new(std::size_t size) {
+  if (failing) {
+    ++throwing_calls;
+    throw std::bad_alloc{};
+  }
+  if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc{};
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept {
+  ++nothrow_calls;
+  if (failing) return nullptr;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+  if (failing) {
+    ++throwing_calls;
+    throw std::bad_alloc{};
+  }
+  auto const al = static_cast<std::size_t>(align);
+  if (void* p = std::aligned_alloc(al, (size + al - 1) / al * al)) return p;
+  throw std::bad_alloc{};
+}
+
+void* operator new(std::size_t size, std::align_val_t align, std::nothrow_t const&) noexcept {
+  ++nothrow_calls;
+  if (failing) return nullptr;
+  auto const al = static_cast<std::size_t>(align);
+  return std::aligned_alloc(al, (size + al - 1) / al * al);
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+using namespace mitama;
+
+template <class T>
+using fvector = std::vector<T, fallible_allocator<T>>;
+
+TEST_CASE("try_push_back", "[memory][fallible]"){
+  fvector<int> v;
+  REQUIRE(try_push_back(v, 1).unwrap() == 1);
+  for (int i = 2; i <= 3; ++i) REQUIRE(try_push_back(v, i).is_ok());
+  REQUIRE(v == fvector<int>{1, 2, 3});
+
+  // the block acquired up front is the one the vector grows into
+  v.shrink_to_fit();
+  nothrow_calls = 0;
+  REQUIRE(try_push_back(v, 4).is_ok());
+  REQUIRE(nothrow_calls == 1);
+  v.pop_back();
+
+  auto emplaced = try_emplace_back(v, 4);
+  int& back = emplaced.unwrap();
+  REQUIRE(&back == &v.back());
+
+  v.shrink_to_fit();
+  auto const before = v;
+  auto res = out_of_memory([&]{ return try_push_back(v, 5); });
+  REQUIRE(res == failure(alloc_error{alloc_error_kind::allocation_failure, 8 * sizeof(int)}));
+  REQUIRE(throwing_calls == 0);
+  REQUIRE(v == before);
+
+  // no allocation needed: succeeds even out of memory
+  REQUIRE(try_reserve(v, 10).is_ok());
+  REQUIRE(out_of_memory([&]{ return try_push_back(v, 5); }).is_ok());
+}
+
+TEST_CASE("try_reserve and try_resize", "[memory][fallible]"){
+  fvector<int> v;
+  REQUIRE(try_reserve(v, 100).is_ok());
+  REQUIRE(v.capacity() >= 100);
+  REQUIRE(try_reserve(v, v.max_size() + 1) == failure(alloc_error{alloc_error_kind::capacity_overflow, 0}));
+
+  REQUIRE(out_of_memory([&]{ return try_resize(v, 1000, 7); }).is_err());
+  REQUIRE(v.empty());
+  REQUIRE(throwing_calls == 0);
+
+  REQUIRE(try_resize(v, 1000, 7).is_ok());
+  REQUIRE(v.size() == 1000);
+  REQUIRE(v[999] == 7);
+
+  REQUIRE(try_resize(v, 1100).is_ok());
+  REQUIRE(v.size() == 1100);
+  REQUIRE(v[1099] == 0);
+}
+
+namespace {
+  // allocates more on each reserve: not a supported container
+  struct shifting {
+    using value_type = int;
+    using allocator_type = fallible_allocator<int>;
+    std::size_t runs = 0;
+
+    std::size_t size() const { return 0; }
+    std::size_t capacity() const { return 0; }
+    std::size_t max_size() const { return 1u << 20; }
+    void reserve(std::size_t n) {
+      allocator_type alloc;
+      auto const count = n * ++runs + n;
+      alloc.deallocate(alloc.allocate(count), count);
+    }
+  };
+}
+
+TEST_CASE("an unsupported container is not reported as out of memory", "[memory][fallible]"){
+  shifting s;
+  REQUIRE_THROWS_AS(try_reserve(s, 4), runtime_panic);
+  REQUIRE(s.runs == 2);
+}
+
+TEST_CASE("try_insert", "[memory][fallible]"){
+  fvector<int> v{1, 3};
+  v.shrink_to_fit();
+  REQUIRE(try_insert(v, v.begin() + 1, 2).unwrap() == 2);
+  REQUIRE(v == fvector<int>{1, 2, 3});
+
+  std::map<int, std::string, std::less<>, fallible_allocator<std::pair<int const, std::string>>> m;
+  REQUIRE(try_insert(m, std::pair{1, std::string{"one"}}).unwrap().second == "one");
+  REQUIRE(try_insert(m, std::pair{1, std::string{"uno"}}).unwrap().second == "one");
+  REQUIRE(out_of_memory([&]{ return try_insert(m, std::pair{2, std::string{}}); }).is_err());
+  REQUIRE(m.size() == 1);
+  REQUIRE(throwing_calls == 0);
+
+  std::set<int, std::less<>, fallible_allocator<int>> s;
+  REQUIRE(try_insert(s, 1).unwrap() == 1);
+
+  std::list<int, fallible_allocator<int>> l{1};
+  REQUIRE(try_push_back(l, 2).unwrap() == 2);
+  REQUIRE(out_of_memory([&]{ return try_insert(l, l.begin(), 0); }).is_err());
+  REQUIRE(l == std::list<int, fallible_allocator<int>>{1, 2});
+}
+
+namespace {
+  // the node of an over-aligned value is larger than the first guess of the node size
+  struct alignas(64) wide {
+    int value;
+    friend bool operator<(wide const& lhs, wide const& rhs) { return lhs.value < rhs.value; }
+  };
+}
+
+TEST_CASE("try_insert observes the node size", "[memory][fallible]"){
+  std::set<wide, std::less<>, fallible_allocator<wide>> s;
+  auto failed = out_of_memory([&]{ return try_insert(s, wide{0}); });
+  REQUIRE(failed.is_err());
+  REQUIRE(throwing_calls == 0);
+  REQUIRE(s.empty());
+
+  REQUIRE(try_insert(s, wide{1}).unwrap().value == 1);
+  // the observed node size is acquired up front: no second allocation
+  auto const calls = nothrow_calls;
+  REQUIRE(try_insert(s, wide{2}).unwrap().value == 2);
+  REQUIRE(nothrow_calls == calls + 1);
+  REQUIRE(out_of_memory([&]{ return try_insert(s, wide{3}); }).is_err());
+  REQUIRE(throwing_calls == 0);
+  REQUIRE(s.size() == 2);
+}
+
+TEST_CASE("fallible strings", "[memory][fallible]"){
+  std::basic_string<char, std::char_traits<char>, fallible_allocator<char>> str = "a long string that is heap allocated";
+  auto const size = str.size();
+  REQUIRE(try_reserve(str, size * 3).is_ok());
+  str.shrink_to_fit();
+  REQUIRE(out_of_memory([&]{ return try_push_back(str, '!'); }).is_err());
+  REQUIRE(str.size() == size);
+  REQUIRE(try_push_back(str, '!').unwrap() == '!');
+}
+
+TEST_CASE("fallible operations on std::allocator containers", "[memory][fallible]"){
+  std::vector<int> v{1};
+  v.shrink_to_fit();
+  REQUIRE(out_of_memory([&]{ return try_push_back(v, 2); }).is_err());
+  REQUIRE(v == std::vector<int>{1});
+  REQUIRE(try_push_back(v, 2).unwrap() == 2);
+}
+
+TEST_CASE("alloc_error is printable", "[memory][fallible]"){
+  std::ostringstream ss;
+  ss << alloc_error{alloc_error_kind::allocation_failure, 64};
+  REQUIRE(ss.str() == "memory allocation of 64 bytes failed");
+}
+
+TEST_CASE("arena try_allocate", "[memory][arena]"){
+  arena request(64);
+  auto allocated = request.try_allocate<int>(42);
+  int& x = allocated.unwrap();
+  REQUIRE(x == 42);
+  REQUIRE(request.owns(&x));
+  REQUIRE(request.used() == sizeof(int));
+
+  auto exhausted = request.try_allocate<std::array<char, 128>>();
+  REQUIRE(exhausted == failure(arena_exhausted{128, 64 - sizeof(int)}));
+  // a failed allocation takes no room
+  REQUIRE(request.used() == sizeof(int));
+
+  request.reset();
+  REQUIRE(request.used() == 0);
+  REQUIRE(request.available() == 64);
+}
+
+TEST_CASE("arena over a caller-provided buffer", "[memory][arena]"){
+  alignas(std::max_align_t) std::byte buffer[32];
+  arena request(buffer, sizeof(buffer));
+  auto allocated = request.try_allocate<double>(1.5);
+  REQUIRE(static_cast<void*>(&allocated.unwrap()) == buffer);
+  REQUIRE(request.try_allocate<char>('a').is_ok());
+  // padded up to the alignment of double
+  REQUIRE(request.try_allocate<double>(2.5).is_ok());
+  REQUIRE(request.used() == 3 * sizeof(double));
+}
+
+namespace {
+  struct counted {
+    static inline int alive = 0;
+    explicit counted(bool fail) {
+      if (fail) throw std::runtime_error("construction failed");
+      ++alive;
+    }
+    ~counted() { --alive; }
+  };
+}
+
+TEST_CASE("arena destroys objects on reset", "[memory][arena]"){
+  {
+    arena request(256);
+    REQUIRE(request.try_allocate<counted>(false).is_ok());
+    REQUIRE(request.try_allocate<counted>(false).is_ok());
+    REQUIRE(counted::alive == 2);
+
+    // a throwing constructor leaves the arena as it was
+    auto const used = request.used();
+    REQUIRE_THROWS_AS(request.try_allocate<counted>(true), std::runtime_error);
+    REQUIRE(request.used() == used);
+
+    request.reset();
+    REQUIRE(counted::alive == 0);
+    REQUIRE(request.try_allocate<counted>(false).is_ok());
+  }
+  REQUIRE(counted::alive == 0);
+}
+
+TEST_CASE("arena as a memory resource", "[memory][arena]"){
+  arena request(256);
+  {
+    std::pmr::vector<int> v({1, 2, 3}, &request);
+    REQUIRE(request.owns(v.data()));
+    REQUIRE(request.live() == 1);
+    REQUIRE_THROWS_AS(request.reset(), runtime_panic);
+  }
+  REQUIRE(request.live() == 0);
+  request.reset();
+
+  // exhaustion throws std::bad_alloc, unless there is an upstream resource to fall back to
+  REQUIRE_THROWS_AS(std::pmr::vector<int>(1000, &request), std::bad_alloc);
+  arena fallback(256, std::pmr::new_delete_resource());
+  std::pmr::vector<int> v(1000, &fallback);
+  REQUIRE(!fallback.owns(v.data()));
+}
+
+#if defined(__unix__)
+#include <csignal>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+TEST_CASE("arena aborts on destruction with live allocations", "[memory][arena]"){
+  pid_t pid = ::fork();
+  REQUIRE(pid != -1);
+  if (pid == 0) {
+    ::dup2(::open("/dev/null", O_WRONLY), STDERR_FILENO);
+    {
+      arena request(256);
+      // outlives the arena
+      new std::pmr::vector<int>({1, 2, 3}, &request);
+    }
+    std::_Exit(0);
+  }
+  int status = 0;
+  REQUIRE(::waitpid(pid, &status, 0) == pid);
+  REQUIRE(WIFSIGNALED(status));
+  REQUIRE(WTERMSIG(status) == SIGABRT);
+}
+#endif
+
+TEST_CASE("arena_exhausted is printable", "[memory][arena]"){
+  std::ostringstream ss;
+  ss << arena_exhausted{128, 60};
+  REQUIRE(ss.str() == "arena exhausted: requested 128 bytes, 60 bytes available");
+}
@@ -0,0 +1,146 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch.hpp>
+
+#include <mitama/result/result.hpp>
+#include <mitama/result/packed_result.hpp>
+#include <mitama/maybe/maybe.hpp>
+
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+using namespace mitama;
+
+enum class status: std::uint8_t { timeout = 1, refused, reset };
+
+std::ostream& operator<<(std::ostream& os, status s) {
+  return os << "status(" << static_cast<int>(s) << ")";
+}
+
+template <>
+struct mitama::packed_bits<status>: std::integral_constant<std::size_t, 2> {};
+
+static_assert(sizeof(packed_result<std::uint32_t, std::uint16_t>) == 8);
+static_assert(sizeof(packed_result<bool, status>) == 1);
+static_assert(sizeof(result<bool, status>) == 2);
+static_assert(sizeof(packed_result<std::uint16_t, status>) == 4);
+static_assert(std::is_trivially_copyable_v<packed_result<std::uint32_t, std::uint16_t>>);
+
+// constexpr
+static_assert(packed_result<std::uint32_t, std::uint16_t>{success(42u)}.unwrap() == 42u);
+static_assert(packed_result<std::uint32_t, std::uint16_t>{failure(std::uint16_t{7})}.unwrap_err() == 7);
+static_assert(packed_result<bool, status>{failure(status::reset)}.map([](bool b) { return !b; }).unwrap_err() == status::reset);
+
+TEST_CASE("packed_result observers", "[packed_result]"){
+  packed_result<std::uint32_t, std::uint16_t> ok = success(0xFFFFFFFFu);
+  packed_result<std::uint32_t, std::uint16_t> err = failure(std::uint16_t{0xFFFF});
+  REQUIRE(ok.is_ok());
+  REQUIRE(err.is_err());
+  REQUIRE(ok.unwrap() == 0xFFFFFFFFu);
+  REQUIRE(err.unwrap_err() == 0xFFFF);
+  REQUIRE(ok == success(0xFFFFFFFFu));
+  REQUIRE(err == failure(0xFFFF));
+  REQUIRE(ok != err);
+  REQUIRE(err.unwrap_or(1) == 1);
+  REQUIRE(err.unwrap_or_else([](std::uint16_t e) { return e + 1u; }) == 0x10000u);
+  REQUIRE(ok.ok() == just(0xFFFFFFFFu));
+  REQUIRE(ok.err() == nothing);
+
+  REQUIRE_THROWS_AS(err.unwrap(), runtime_panic);
+  REQUIRE_THROWS_AS(ok.unwrap_err(), runtime_panic);
+}
+
+TEST_CASE("packed_result combinators", "[packed_result]"){
+  using packed = packed_result<bool, status>;
+  packed ok = success(true);
+  packed err = failure(status::refused);
+
+  REQUIRE(ok.map([](bool b) { return b ? 1 : 0; }) == success(1));
+  REQUIRE(err.map_err([](status s) { return static_cast<int>(s); }) == failure(2));
+  REQUIRE(ok.and_then([](bool b) -> packed { return failure(b ? status::timeout : status::reset); }) == failure(status::timeout));
+  REQUIRE(err.or_else([](status) -> packed { return success(false); }) == success(false));
+  REQUIRE(err.and_then([](bool) -> packed { return success(true); }) == err);
+}
+
+TEST_CASE("packed_result and result", "[packed_result]"){
+  result<int, status> res = failure(status::reset);
+  packed_result packed{res};
+  static_assert(std::is_same_v<decltype(packed), packed_result<int, status>>);
+  REQUIRE(packed.to_result() == res);
+  REQUIRE(packed_result<int, status>::from_bits(packed.to_bits()) == packed);
+
+  std::ostringstream ss;
+  ss << packed << ' ' << packed_result<int, status>{success(1)};
+  REQUIRE(ss.str() == "failure(status(3)) success(1)");
+}
+
+TEST_CASE("packed_result of a pointer", "[packed_result]"){
+  struct alignas(8) node { int value; };
+  using packed = packed_result<node*, status>;
+  static_assert(sizeof(packed) == sizeof(void*));
+  static_assert(std::is_same_v<packed::storage_type, std::uintptr_t>);
+  static_assert(std::is_trivially_copyable_v<packed>);
+
+  node n{42};
+  packed ok = success(&n);
+  packed null = success(nullptr);
+  packed err = failure(status::refused);
+  REQUIRE(ok.is_ok());
+  REQUIRE(null.is_ok());
+  REQUIRE(err.is_err());
+  REQUIRE(ok.unwrap() == &n);
+  REQUIRE(null.unwrap() == nullptr);
+  REQUIRE(err.unwrap_err() == status::refused);
+  // the address itself for a success, the error tagged in the lowest bit for a failure
+  REQUIRE(ok.to_bits() == reinterpret_cast<std::uintptr_t>(&n));
+  REQUIRE((err.to_bits() & 1) == 1);
+  REQUIRE(packed::from_bits(err.to_bits()) == err);
+
+  REQUIRE(err.unwrap_or(&n) == &n);
+  REQUIRE(ok.unwrap_or(nullptr) == &n);
+  REQUIRE(ok.map([](node* p) { return p->value; }) == success(42));
+  REQUIRE(ok.and_then([](node* p) -> packed { return failure(p->value > 0 ? status::timeout : status::reset); }) == failure(status::timeout));
+  REQUIRE(err.to_result() == failure(status::refused));
+  REQUIRE_THROWS_AS(err.unwrap(), runtime_panic);
+
+  // the error may use every bit but the lowest
+  packed_result<node*, std::uint32_t> wide = failure(0xFFFFFFFFu);
+  REQUIRE(wide.unwrap_err() == 0xFFFFFFFFu);
+}
+
+namespace {
+  template <class Results>
+  long sum(Results const& results) {
+    long n = 0;
+    for (auto const& r: results) n += r.unwrap_or(0);
+    return n;
+  }
+}
+
+TEST_CASE("packed_result vs result on large arrays", "[packed_result][!benchmark]"){
+  constexpr std::size_t n = std::size_t{1} << 25;
+  std::vector<result<bool, status>> results;
+  std::vector<packed_result<bool, status>> packed;
+  std::vector<result<std::uint32_t, std::uint16_t>> results32;
+  std::vector<packed_result<std::uint32_t, std::uint16_t>> packed32;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i % 7 == 0) {
+      results.push_back(failure(status::timeout));
+      results32.push_back(failure(std::uint16_t{1}));
+    }
+    else {
+      results.push_back(success(i % 3 == 0));
+      results32.push_back(success(static_cast<std::uint32_t>(i)));
+    }
+    packed.emplace_back(results.back());
+    packed32.emplace_back(results32.back());
+  }
+
+  BENCHMARK("result<bool, status>") { return sum(results); };
+  BENCHMARK("packed_result<bool, status>") { return sum(packed); };
+  BENCHMARK("result<uint32_t, uint16_t>") { return sum(results32); };
+  BENCHMARK("packed_result<uint32_t, uint16_t>") { return sum(packed32); };
+}
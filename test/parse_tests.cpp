@@ -0,0 +1,132 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch.hpp>
+
+#include <mitama/result/result.hpp>
+#include <mitama/parse.hpp>
+
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+using namespace mitama;
+using namespace std::literals;
+
+static_assert(sizeof(parse_error) == 8);
+static_assert(std::is_trivially_copyable_v<parse_error>);
+
+namespace {
+  constexpr parse_error invalid(std::uint32_t offset) { return {offset, parse_error_kind::invalid_character}; }
+  constexpr parse_error out_of_range{0, parse_error_kind::out_of_range};
+}
+
+TEST_CASE("parse integers", "[parse]"){
+  REQUIRE(parse<int>("0") == success(0));
+  REQUIRE(parse<int>("42") == success(42));
+  REQUIRE(parse<int>("-42") == success(-42));
+  REQUIRE(parse<unsigned>("4294967295") == success(4294967295u));
+  // longer than the fast path: eight digits at a time, then the rest
+  REQUIRE(parse<std::int64_t>("123456789012345678") == success(123456789012345678));
+  REQUIRE(parse<std::int64_t>("-9223372036854775808") == success(std::numeric_limits<std::int64_t>::min()));
+  REQUIRE(parse<std::uint64_t>("18446744073709551615") == success(std::numeric_limits<std::uint64_t>::max()));
+  REQUIRE(parse<int>("00000000000000000001") == success(1));
+  REQUIRE(parse<std::int8_t>("-128") == success(std::int8_t{-128}));
+}
+
+TEST_CASE("parse errors", "[parse]"){
+  REQUIRE(parse<int>("") == failure(parse_error{0, parse_error_kind::empty}));
+  REQUIRE(parse<int>("-") == failure(invalid(1)));
+  REQUIRE(parse<int>("+1") == failure(invalid(0)));
+  REQUIRE(parse<int>(" 1") == failure(invalid(0)));
+  REQUIRE(parse<int>("12a") == failure(invalid(2)));
+  REQUIRE(parse<int>("1234567x") == failure(invalid(7)));
+  REQUIRE(parse<std::int64_t>("12345678x0123") == failure(invalid(8)));
+  REQUIRE(parse<unsigned>("-1") == failure(invalid(0)));
+  REQUIRE(parse<int>("2147483648") == failure(out_of_range));
+  REQUIRE(parse<std::uint8_t>("256") == failure(out_of_range));
+  REQUIRE(parse<std::uint64_t>("18446744073709551616") == failure(out_of_range));
+}
+
+enum class color: std::uint8_t { red, green, blue };
+
+TEST_CASE("parse enumerations", "[parse]"){
+  REQUIRE(parse<color>("2") == success(color::blue));
+  REQUIRE(parse<color>("256") == failure(out_of_range));
+}
+
+#if defined(__cpp_lib_to_chars)
+TEST_CASE("parse floating point numbers", "[parse]"){
+  REQUIRE(parse<double>("1.5") == success(1.5));
+  REQUIRE(parse<double>("-2.5e3") == success(-2500.0));
+  REQUIRE(parse<double>("1.5x") == failure(invalid(3)));
+  REQUIRE(parse<double>("-x") == failure(invalid(1)));
+  REQUIRE(parse<float>("1e100") == failure(out_of_range));
+}
+#endif
+
+TEST_CASE("parse_all", "[parse]"){
+  std::vector<std::string> const inputs{"1", "x", "3", "", "5"};
+  auto column = parse_all<int>(inputs);
+  REQUIRE(column.size() == 5);
+  REQUIRE_FALSE(column.all_ok());
+  REQUIRE(column.values == std::vector<int>{1, 0, 3, 0, 5});
+  REQUIRE(column.failed_rows == std::vector<std::size_t>{1, 3});
+  REQUIRE(column.errors == std::vector<parse_error>{invalid(0), parse_error{0, parse_error_kind::empty}});
+  REQUIRE(column[2] == success(3));
+  REQUIRE(column[3] == failure(parse_error{0, parse_error_kind::empty}));
+
+  column.clear();
+  parse_all(std::vector<std::string_view>{"7", "8"}, column);
+  REQUIRE(column.all_ok());
+  REQUIRE(column.values == std::vector<int>{7, 8});
+}
+
+TEST_CASE("parse_error is printable", "[parse]"){
+  std::ostringstream ss;
+  ss << invalid(3);
+  REQUIRE(ss.str() == "invalid character at offset 3");
+}
+
+TEST_CASE("parse vs std::stoi", "[parse][!benchmark]"){
+  std::vector<std::string> inputs;
+  for (int i = 0; i < 1024; ++i)
+    inputs.push_back(std::to_string(i * 2654435761u % 1000000007u));
+  inputs[512] = "not a number";
+
+  BENCHMARK("std::stoi + try/catch") {
+    long sum = 0;
+    for (auto const& s: inputs) {
+      try { sum += std::stoi(s); }
+      catch (std::invalid_argument const&) {}
+    }
+    return sum;
+  };
+
+  BENCHMARK("std::from_chars") {
+    long sum = 0;
+    for (auto const& s: inputs) {
+      int v = 0;
+      std::from_chars(s.data(), s.data() + s.size(), v);
+      sum += v;
+    }
+    return sum;
+  };
+
+  BENCHMARK("parse<int>") {
+    long sum = 0;
+    for (auto const& s: inputs)
+      sum += parse<int>(s).unwrap_or(0);
+    return sum;
+  };
+
+  BENCHMARK("parse_all<int>") {
+    return parse_all<int>(inputs).values.size();
+  };
+}
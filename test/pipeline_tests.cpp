@@ -0,0 +1,239 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch.hpp>
+
+#include <mitama/pipeline.hpp>
+#include <mitama/result/result.hpp>
+#include <mitama/maybe/maybe.hpp>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace mitama;
+using namespace std::literals;
+
+namespace {
+  result<int, std::string> half(int x) {
+    if (x % 2 == 0) return success(x / 2);
+    else return failure("odd: "s + std::to_string(x));
+  }
+
+  maybe<int> half_just(int x) {
+    if (x % 2 == 0) return just(x / 2);
+    else return nothing;
+  }
+}
+
+TEST_CASE("pipeline on success", "[pipeline][result]"){
+  result<int, std::string> r = success(8);
+
+  result<std::string, std::string> out = r
+    | mitama::map([](int x) { return x + 4; })
+    | mitama::and_then(half)
+    | mitama::map_err([](std::string const& e) { return "error: " + e; })
+    | mitama::map([](int x) { return std::to_string(x); });
+
+  REQUIRE(out == success("6"s));
+  // the lvalue source is left untouched
+  REQUIRE(r == success(8));
+}
+
+TEST_CASE("pipeline on failure", "[pipeline][result]"){
+  int calls = 0;
+  auto count = [&calls](int x) { ++calls; return x; };
+
+  auto from_failure = (result<int, std::string>{failure("bad"s)}
+    | mitama::map(count)
+    | mitama::and_then(half)
+    | mitama::map_err([](std::string const& e) { return e.size(); })
+    | mitama::map(count)).eval();
+  static_assert(std::is_same_v<decltype(from_failure), result<int, std::size_t>>);
+  REQUIRE(from_failure == failure(3u));
+  REQUIRE(calls == 0);
+
+  auto from_and_then = (result<int, std::string>{success(3)}
+    | mitama::and_then(half)
+    | mitama::map(count)).eval();
+  REQUIRE(from_and_then == failure("odd: 3"s));
+  REQUIRE(calls == 0);
+}
+
+TEST_CASE("pipeline recovers with or_else", "[pipeline][result]"){
+  auto recover = [](std::string const& e) -> result<long, int> { return success(static_cast<long>(e.size())); };
+
+  result<long, int> recovered = result<int, std::string>{failure("four"s)}
+    | mitama::or_else(recover)
+    | mitama::map([](long x) { return x * 10; });
+  REQUIRE(recovered == success(40l));
+
+  // or_else is skipped on success, but converts the success value to its ok_type
+  result<long, int> skipped = result<int, std::string>{success(7)}
+    | mitama::or_else(recover);
+  REQUIRE(skipped == success(7l));
+}
+
+TEST_CASE("pipeline skips stages after a type change", "[pipeline][result]"){
+  auto parse = [](std::string const& s) -> result<int, std::string> {
+    if (s.empty()) return failure("empty"s);
+    return success(static_cast<int>(s.size()));
+  };
+  auto recover = [](std::size_t e) -> result<int, long> { return success(static_cast<int>(e)); };
+
+  // and_then is skipped on failure; it is typed by the output of map
+  auto and_then_skipped = (result<int, std::string>{failure("bad"s)}
+    | mitama::map([](int x) { return std::to_string(x); })
+    | mitama::and_then(parse)).eval();
+  static_assert(std::is_same_v<decltype(and_then_skipped), result<int, std::string>>);
+  REQUIRE(and_then_skipped == failure("bad"s));
+
+  auto and_then_taken = (result<int, std::string>{success(123)}
+    | mitama::map([](int x) { return std::to_string(x); })
+    | mitama::and_then(parse)).eval();
+  REQUIRE(and_then_taken == success(3));
+
+  // or_else is skipped on success; it is typed by the output of map_err
+  auto or_else_skipped = (result<int, std::string>{success(5)}
+    | mitama::map_err([](std::string const& e) { return e.size(); })
+    | mitama::or_else(recover)).eval();
+  static_assert(std::is_same_v<decltype(or_else_skipped), result<int, long>>);
+  REQUIRE(or_else_skipped == success(5));
+
+  auto or_else_taken = (result<int, std::string>{failure("four"s)}
+    | mitama::map_err([](std::string const& e) { return e.size(); })
+    | mitama::or_else(recover)).eval();
+  REQUIRE(or_else_taken == success(4));
+}
+
+TEST_CASE("pipeline adaptors compose", "[pipeline][result]"){
+  auto normalize = mitama::map([](int x) { return x * 2; }) | mitama::and_then(half);
+  auto describe = mitama::map([](int x) { return std::to_string(x); })
+                | mitama::map_err([](std::string const& e) { return e.size(); });
+
+  result<std::string, std::size_t> out = result<int, std::string>{success(21)} | normalize | describe;
+  REQUIRE(out == success("21"s));
+
+  auto partial = result<int, std::string>{success(5)} | normalize;
+  result<std::string, std::size_t> composed = std::move(partial) | describe;
+  REQUIRE(composed == success("5"s));
+}
+
+TEST_CASE("pipeline moves out of rvalue sources", "[pipeline][result]"){
+  auto out = (result<std::unique_ptr<int>, std::string>{success(std::make_unique<int>(41))}
+    | mitama::map([](std::unique_ptr<int> p) { *p += 1; return p; })
+    | mitama::map([](std::unique_ptr<int> p) { return *p; })).eval();
+  REQUIRE(out == success(42));
+}
+
+TEST_CASE("pipeline with void map", "[pipeline][result]"){
+  int seen = 0;
+  auto out = (result<int, std::string>{success(3)}
+    | mitama::map([&seen](int x) { seen = x; })).eval();
+  static_assert(std::is_same_v<decltype(out), result<std::monostate, std::string>>);
+  REQUIRE(out.is_ok());
+  REQUIRE(seen == 3);
+}
+
+TEST_CASE("pipeline on maybe", "[pipeline][maybe]"){
+  maybe<int> m = just(8);
+
+  maybe<std::string> out = m
+    | mitama::map([](int x) { return x + 4; })
+    | mitama::and_then(half_just)
+    | mitama::map([](int x) { return std::to_string(x); });
+  REQUIRE(out == just("6"s));
+  REQUIRE(m == just(8));
+
+  maybe<int> none = maybe<int>{just(3)}
+    | mitama::and_then(half_just)
+    | mitama::map([](int) -> int { FAIL("unreachable"); return 0; });
+  REQUIRE(none == nothing);
+
+  maybe<int> recovered = maybe<int>{}
+    | mitama::or_else([]{ return maybe<int>{just(1)}; })
+    | mitama::map([](int x) { return x + 1; });
+  REQUIRE(recovered == just(2));
+}
+
+namespace constexpr_test {
+  constexpr result<int, int> checked_half(int x) {
+    if (x % 2 == 0) return success(x / 2);
+    else return failure(x);
+  }
+
+  constexpr result<int, int> run(int x) {
+    return result<int, int>{success(x)}
+      | mitama::map([](int v) { return v * 3; })
+      | mitama::and_then(checked_half)
+      | mitama::map_err([](int e) { return -e; });
+  }
+}
+
+TEST_CASE("pipeline in constant expressions", "[pipeline][constexpr]"){
+  static_assert(constexpr_test::run(4).unwrap() == 6);
+  static_assert(constexpr_test::run(3).unwrap_err() == -9);
+  REQUIRE(constexpr_test::run(4) == success(6));
+}
+
+namespace bench {
+  result<int, std::string> step(int x) {
+    if (x < 0) return failure("negative"s);
+    return success(x + 1);
+  }
+
+  std::vector<result<int, std::string>> inputs() {
+    std::vector<result<int, std::string>> v;
+    for (int i = 0; i < 1024; ++i) {
+      if (i % 16 == 0) v.emplace_back(failure("input"s));
+      else v.emplace_back(success(i));
+    }
+    return v;
+  }
+
+  inline constexpr auto twice = [](int x) { return x * 2; };
+  inline constexpr auto describe = [](std::string const& e) { return e.size(); };
+  inline constexpr auto decrement = [](int x) { return x - 1; };
+}
+
+TEST_CASE("pipeline vs method chain", "[pipeline][!benchmark]"){
+  auto const in = bench::inputs();
+
+  BENCHMARK("method chain") {
+    long sum = 0;
+    for (auto const& r: in)
+      sum += r.map(bench::twice).and_then(bench::step).map_err(bench::describe).map(bench::decrement).unwrap_or(0);
+    return sum;
+  };
+
+  BENCHMARK("pipeline") {
+    long sum = 0;
+    for (auto const& r: in)
+      sum += (r | mitama::map(bench::twice) | mitama::and_then(bench::step)
+                | mitama::map_err(bench::describe) | mitama::map(bench::decrement)).eval().unwrap_or(0);
+    return sum;
+  };
+}
+
+TEST_CASE("maybe pipeline vs method chain", "[pipeline][!benchmark]"){
+  std::vector<maybe<int>> in;
+  for (int i = 0; i < 1024; ++i)
+    in.push_back(i % 16 == 0 ? maybe<int>{} : maybe<int>{just(i)});
+  auto const step = [](int x) { return x % 3 == 0 ? maybe<int>{} : maybe<int>{just(x + 1)}; };
+
+  BENCHMARK("method chain") {
+    long sum = 0;
+    for (auto const& m: in)
+      sum += m.map(bench::twice).and_then(step).map(bench::decrement).unwrap_or(0);
+    return sum;
+  };
+
+  BENCHMARK("pipeline") {
+    long sum = 0;
+    for (auto const& m: in)
+      sum += (m | mitama::map(bench::twice) | mitama::and_then(step) | mitama::map(bench::decrement)).eval().unwrap_or(0);
+    return sum;
+  };
+}
@@ -440,6 +440,60 @@ TEST_CASE("or_peek() test", "[result][and_peek]"){
   REQUIRE(x.or_peek([](std::string& v){ v = "bar"; }) == failure("bar"s));
 }
 
+TEST_CASE("rvalue combinators with move-only types test", "[result][rvalue]"){
+  using ptr = std::unique_ptr<int>;
+  SECTION("ok() && / err() &&") {
+    maybe<ptr> x = mut_result<ptr, ptr>{in_place_ok, new int(1)}.ok();
+    REQUIRE(*x.unwrap() == 1);
+    maybe<ptr> y = mut_result<ptr, ptr>{in_place_err, new int(2)}.err();
+    REQUIRE(*y.unwrap() == 2);
+    REQUIRE_FALSE(mut_result<ptr, ptr>{in_place_err, new int(3)}.ok());
+  }
+  SECTION("conj") {
+    auto res = mut_result<ptr, ptr>{in_place_ok, new int(1)}.conj(mut_result<ptr, ptr>{in_place_ok, new int(2)});
+    REQUIRE(*res.unwrap() == 2);
+    auto err = mut_result<ptr, ptr>{in_place_err, new int(3)} && mut_result<ptr, ptr>{in_place_ok, new int(4)};
+    REQUIRE(*err.unwrap_err() == 3);
+    mut_result<int, str> lhs = success(1);
+    auto mixed = lhs && mut_result<ptr, str>{in_place_ok, new int(5)};
+    REQUIRE(*mixed.unwrap() == 5);
+  }
+  SECTION("disj") {
+    auto res = mut_result<ptr, ptr>{in_place_err, new int(1)}.disj(mut_result<ptr, ptr>{in_place_ok, new int(2)});
+    REQUIRE(*res.unwrap() == 2);
+    auto ok = mut_result<ptr, ptr>{in_place_ok, new int(3)} || mut_result<ptr, ptr>{in_place_err, new int(4)};
+    REQUIRE(*ok.unwrap() == 3);
+    mut_result<str, int> lhs = failure(1);
+    auto mixed = lhs || mut_result<str, ptr>{in_place_err, new int(5)};
+    REQUIRE(*mixed.unwrap_err() == 5);
+  }
+  SECTION("unwrap_or_else") {
+    ptr x = mut_result<ptr, ptr>{in_place_ok, new int(1)}.unwrap_or_else([](ptr e){ return e; });
+    REQUIRE(*x == 1);
+    ptr y = mut_result<ptr, ptr>{in_place_err, new int(2)}.unwrap_or_else([](ptr e){ return e; });
+    REQUIRE(*y == 2);
+  }
+  SECTION("unwrap_or_default") {
+    ptr x = mut_result<ptr, int>{in_place_ok, new int(1)}.unwrap_or_default();
+    REQUIRE(*x == 1);
+    ptr y = mut_result<ptr, int>{in_place_err, 1}.unwrap_or_default();
+    REQUIRE(y == nullptr);
+  }
+  SECTION("transpose") {
+    auto x = mut_result<maybe<ptr>, int>{in_place_ok, just(std::make_unique<int>(1))}.transpose();
+    REQUIRE(*x.unwrap().unwrap() == 1);
+    auto y = mut_result<maybe<ptr>, ptr>{in_place_err, new int(2)}.transpose();
+    REQUIRE(*y.unwrap().unwrap_err() == 2);
+  }
+  SECTION("and_finally / or_finally") {
+    ptr hook;
+    mut_result<ptr, ptr>{in_place_ok, new int(1)}.and_finally([&hook](ptr v){ hook = std::move(v); });
+    REQUIRE(*hook == 1);
+    mut_result<ptr, ptr>{in_place_err, new int(2)}.or_finally([&hook](ptr v){ hook = std::move(v); });
+    REQUIRE(*hook == 2);
+  }
+}
+
 TEST_CASE("basics test", "[result][basics]"){
   auto even = [](u32 u) -> result<u32, str> {
     if (u % 2 == 0)
@@ -1315,3 +1369,44 @@ TEST_CASE("MITAMA_TRY2", "[result][mitama_try]"){
     return mitama::failure();
   }();
 }
+
+namespace constexpr_test {
+  enum class parse_error { empty, not_a_digit };
+
+  inline std::ostream& operator<<(std::ostream& os, parse_error e) {
+    return os << (e == parse_error::empty ? "empty" : "not a digit");
+  }
+
+  constexpr result<int, parse_error> parse_digit(std::string_view str) {
+    if (str.empty()) return failure(parse_error::empty);
+    if (str[0] < '0' || '9' < str[0]) return failure(parse_error::not_a_digit);
+    return success(str[0] - '0');
+  }
+
+  constexpr result<int, parse_error> parse_pair(std::string_view str) {
+    return parse_digit(str).and_then([str](int tens) {
+      return parse_digit(str.substr(1)).map([tens](int ones) { return tens * 10 + ones; });
+    });
+  }
+}
+
+TEST_CASE("constexpr result test", "[result][constexpr]"){
+  using namespace constexpr_test;
+  static_assert(parse_digit("7").unwrap() == 7);
+  static_assert(parse_digit("").unwrap_err() == parse_error::empty);
+  static_assert(parse_digit("x").is_err());
+  static_assert(parse_digit("7").expect("a digit") == 7);
+  static_assert(parse_digit("x").expect_err("not a digit") == parse_error::not_a_digit);
+  static_assert(parse_digit("x").unwrap_or(0) == 0);
+  static_assert(parse_digit("x").unwrap_or_else([](parse_error){ return -1; }) == -1);
+  static_assert(parse_digit("x").unwrap_or_else([]{ return -2; }) == -2);
+  static_assert(parse_pair("42").unwrap() == 42);
+  static_assert(parse_pair("4").unwrap_err() == parse_error::empty);
+  static_assert(parse_pair("42").ok() == just(42));
+  static_assert(parse_digit("7").as_ref().unwrap() == 7);
+
+  // a panic at compile time is a compile error:
+  //   static_assert(parse_digit("x").unwrap() == 0);
+  //   error: call to non-'constexpr' function 'void mitama::panicked_during_constant_evaluation()'
+  REQUIRE_THROWS_AS(parse_digit("x").unwrap(), runtime_panic);
+}
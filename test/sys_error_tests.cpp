@@ -0,0 +1,62 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include <mitama/result/result.hpp>
+#include <mitama/sys_error.hpp>
+
+#include <cerrno>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace mitama;
+
+static_assert(sizeof(sys_error) == 4);
+static_assert(std::is_trivially_copyable_v<sys_error>);
+static_assert(sizeof(result<int, sys_error>) == 8);
+static_assert(std::is_trivially_copyable_v<result<int, sys_error>>);
+
+namespace {
+  auto checked_dup(int fd) -> result<int, sys_error> {
+    if (int ret = ::dup(fd); ret != -1) return success(ret);
+    return failure(sys_error::last());
+  }
+}
+
+TEST_CASE("sys_error from errno", "[sys_error]"){
+  REQUIRE(checked_dup(-1) == failure(sys_error{EBADF}));
+  REQUIRE(checked_dup(-1) == failure(sys_error{std::errc::bad_file_descriptor}));
+
+  auto fd = checked_dup(STDIN_FILENO);
+  REQUIRE(fd.is_ok());
+  ::close(fd.unwrap());
+}
+
+TEST_CASE("sys_error message", "[sys_error]"){
+  sys_error err{ENOENT};
+  char buf[64];
+  REQUIRE(err.message(buf) == "No such file or directory");
+  REQUIRE(err.message() == "No such file or directory");
+
+  // truncated to the buffer, never overflowing it
+  char small[4];
+  REQUIRE(err.message(small).size() < sizeof(small));
+
+  std::ostringstream ss;
+  ss << err;
+  REQUIRE(ss.str() == "No such file or directory");
+}
+
+TEST_CASE("sys_error and std::error_code", "[sys_error]"){
+  std::error_code ec = sys_error{ENOENT};
+  REQUIRE(ec == std::errc::no_such_file_or_directory);
+  REQUIRE(sys_error{ec} == sys_error{ENOENT});
+  REQUIRE(sys_error{std::make_error_code(std::errc::permission_denied)} == sys_error{EACCES});
+  REQUIRE(sys_error{std::make_error_code(std::io_errc::stream)}.code() == std::make_error_code(std::io_errc::stream).default_error_condition().value());
+}
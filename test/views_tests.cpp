@@ -0,0 +1,102 @@
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
+
+#include <mitama/views.hpp>
+#include <mitama/result/result.hpp>
+#include <mitama/maybe/maybe.hpp>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+
+using namespace mitama;
+using namespace std::literals;
+
+namespace {
+  std::vector<result<int, std::string>> records() {
+    return {
+      success(1), failure("a"s), success(2), success(3), failure("b"s), success(4),
+    };
+  }
+
+  template <class Range>
+  auto to_vector(Range&& range) {
+    std::vector<std::remove_cvref_t<std::ranges::range_reference_t<Range>>> v;
+    for (auto&& x: range) v.push_back(x);
+    return v;
+  }
+}
+
+TEST_CASE("views::oks", "[views][result]"){
+  auto rs = records();
+  REQUIRE(to_vector(rs | views::oks) == std::vector{1, 2, 3, 4});
+
+  // yields references into the underlying results
+  static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(rs | views::oks)>, int&>);
+  for (int& x: rs | views::oks) x *= 10;
+  REQUIRE(rs[0] == success(10));
+
+  auto const& crs = rs;
+  static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(crs | views::oks)>, int const&>);
+}
+
+TEST_CASE("views::errs", "[views][result]"){
+  auto rs = records();
+  REQUIRE(to_vector(rs | views::errs) == std::vector{"a"s, "b"s});
+  static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(rs | views::errs)>, std::string&>);
+}
+
+TEST_CASE("views::justs", "[views][maybe]"){
+  std::vector<maybe<int>> ms{just(1), nothing, just(3)};
+  REQUIRE(to_vector(ms | views::justs) == std::vector{1, 3});
+  static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(ms | views::justs)>, int&>);
+}
+
+TEST_CASE("views::unwrap_or", "[views]"){
+  auto rs = records();
+  REQUIRE(to_vector(rs | views::unwrap_or(0)) == std::vector{1, 0, 2, 3, 0, 4});
+
+  std::vector<maybe<int>> ms{just(1), nothing};
+  REQUIRE(to_vector(ms | views::unwrap_or(-1)) == std::vector{1, -1});
+}
+
+TEST_CASE("views::transform_ok", "[views][result]"){
+  auto rs = records();
+  auto mapped = rs | views::transform_ok([](int x) { return x * 2; });
+  std::vector<result<int, std::string>> expected{
+    success(2), failure("a"s), success(4), success(6), failure("b"s), success(8),
+  };
+  REQUIRE(to_vector(mapped) == expected);
+}
+
+TEST_CASE("views::take_while_ok", "[views]"){
+  auto rs = records();
+  REQUIRE(to_vector(rs | views::take_while_ok) == std::vector{1});
+
+  std::vector<maybe<int>> ms{just(1), just(2), nothing, just(3)};
+  REQUIRE(to_vector(ms | views::take_while_ok) == std::vector{1, 2});
+}
+
+TEST_CASE("views compose with std::views", "[views]"){
+  auto rs = records();
+  auto view = rs
+    | std::views::reverse
+    | views::transform_ok([](int x) { return x + 1; })
+    | views::oks
+    | std::views::take(2);
+  // prvalue results yield values
+  static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(view)>, int>);
+  REQUIRE(to_vector(view) == std::vector{5, 4});
+
+  auto composed = views::oks | std::views::transform([](int x) { return x * x; });
+  REQUIRE(to_vector(rs | composed) == std::vector{1, 4, 9, 16});
+}
+#else
+TEST_CASE("views require C++20 ranges", "[views]"){
+  SUCCEED("<ranges> is not available");
+}
+#endif